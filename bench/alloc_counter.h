@@ -0,0 +1,11 @@
+#ifndef SVG_BENCH_ALLOC_COUNTER_H_
+#define SVG_BENCH_ALLOC_COUNTER_H_
+
+#include <cstddef>
+
+namespace bench {
+// Number of global operator new calls made so far by the process.
+size_t AllocationCount();
+}
+
+#endif // SVG_BENCH_ALLOC_COUNTER_H_
@@ -0,0 +1,61 @@
+#include <memory_resource>
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "alloc_counter.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/writer.h"
+
+namespace {
+// Builds, renders and destroys a per-request document of routes and labels.
+void Request(std::pmr::memory_resource *resource, std::string &out) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 1000);
+  svg::Document doc(resource);
+  for (int i = 0; i < 1000; ++i) {
+    svg::Polyline polyline{svg::Allocator(resource)};
+    for (int j = 0; j < 8; ++j) {
+      polyline.AddPoint({coord(gen), coord(gen)});
+    }
+    doc.Add(std::move(polyline));
+    svg::Text text{svg::Allocator(resource)};
+    text.SetPoint({coord(gen), coord(gen)})
+        .SetData("a label long enough to leave SSO");
+    doc.Add(std::move(text));
+  }
+
+  out.clear();
+  svg::StringSink sink(out);
+  svg::Writer writer(sink);
+  doc.Render(writer);
+}
+
+void BM_RequestHeap(benchmark::State &state) {
+  std::string out;
+  size_t allocations = bench::AllocationCount();
+  for (auto _ : state) {
+    Request(std::pmr::new_delete_resource(), out);
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      bench::AllocationCount() - allocations,
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RequestHeap);
+
+void BM_RequestArena(benchmark::State &state) {
+  std::string out;
+  std::pmr::monotonic_buffer_resource arena(1 << 20);
+  size_t allocations = bench::AllocationCount();
+  for (auto _ : state) {
+    Request(&arena, out);
+    arena.release();
+  }
+  state.counters["allocs"] = benchmark::Counter(
+      bench::AllocationCount() - allocations,
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RequestArena);
+}
@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "scene.h"
+#include "svg/batch.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/writer.h"
+
+namespace {
+// Tile-like documents of 20-200 objects and a few of 20000.
+std::vector<svg::Document> Documents() {
+  std::vector<svg::Document> docs(2000);
+  for (size_t i = 0; i < docs.size(); ++i) {
+    size_t count = i % 500 == 0 ? 20000 : 20 + i % 181;
+    for (auto &object : bench::Scene(count, static_cast<uint32_t>(i))) {
+      docs[i].Add(std::move(object));
+    }
+  }
+  return docs;
+}
+
+// Argument 0 renders the documents one by one on this thread, others are
+// the batch threads.
+void BM_RenderBatch(benchmark::State &state) {
+  auto docs = Documents();
+  std::vector<std::unique_ptr<svg::CallbackSink>> sinks;
+  std::vector<svg::BatchItem> items;
+  std::vector<size_t> sizes(docs.size());
+  for (size_t i = 0; i < docs.size(); ++i) {
+    sinks.push_back(std::make_unique<svg::CallbackSink>(
+        [&doc_size = sizes[i]](std::string_view data) {
+          doc_size += data.size();
+        }));
+    items.push_back({&docs[i], sinks.back().get()});
+  }
+
+  for (auto _ : state) {
+    if (state.range(0) == 0) {
+      for (auto &item : items) {
+        svg::Writer writer(*item.sink);
+        item.document->Render(writer);
+      }
+    } else {
+      svg::RenderBatch(items,
+                       {.threads = static_cast<size_t>(state.range(0))});
+    }
+  }
+  size_t size = 0;
+  for (size_t doc_size : sizes) {
+    size += doc_size;
+  }
+  state.SetItemsProcessed(state.iterations() * docs.size());
+  state.SetBytesProcessed(static_cast<int64_t>(size));
+}
+BENCHMARK(BM_RenderBatch)->Arg(0)
+    ->RangeMultiplier(2)->Range(1, std::thread::hardware_concurrency())
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,55 @@
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/compact_document.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/writer.h"
+
+namespace {
+// Stop layer: circles in a handful of styles.
+template<typename DocumentType>
+void Stops(DocumentType &doc, size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  for (size_t i = 0; i < count; ++i) {
+    doc.Add(svg::Circle{}
+                .SetCenter({coord(gen), coord(gen)})
+                .SetRadius(3)
+                .SetFillColor(i % 2 == 0 ? "white" : "black"));
+  }
+}
+
+template<typename DocumentType>
+void BM_Build(benchmark::State &state) {
+  for (auto _ : state) {
+    DocumentType doc;
+    Stops(doc, state.range(0));
+    benchmark::DoNotOptimize(doc);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Build, svg::Document)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Build, svg::CompactDocument)->Arg(100000);
+
+template<typename DocumentType>
+void BM_Render(benchmark::State &state) {
+  DocumentType doc;
+  Stops(doc, state.range(0));
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+    writer.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK_TEMPLATE(BM_Render, svg::Document)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Render, svg::CompactDocument)->Arg(100000);
+}
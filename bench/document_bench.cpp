@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "alloc_counter.h"
+#include "scene.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/writer.h"
+
+namespace {
+constexpr size_t kFiguresPerIteration = 10000;
+
+template<typename FigureType>
+void BM_RenderFigure(benchmark::State &state) {
+  auto figures = bench::Figures<FigureType>(kFiguresPerIteration);
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    for (auto &figure : figures) {
+      figure.Render(writer);
+    }
+    writer.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * figures.size());
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK_TEMPLATE(BM_RenderFigure, svg::Circle);
+BENCHMARK_TEMPLATE(BM_RenderFigure, svg::Polyline);
+BENCHMARK_TEMPLATE(BM_RenderFigure, svg::Text);
+BENCHMARK_TEMPLATE(BM_RenderFigure, svg::Rectangle);
+
+// One-off std::ostream renders of single figures.
+template<typename FigureType>
+void BM_RenderFigureOstream(benchmark::State &state) {
+  auto figures = bench::Figures<FigureType>(kFiguresPerIteration);
+
+  std::ostringstream ss;
+  for (auto _ : state) {
+    ss.str({});
+    for (auto &figure : figures) {
+      figure.Render(ss);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * figures.size());
+}
+BENCHMARK_TEMPLATE(BM_RenderFigureOstream, svg::Circle);
+BENCHMARK_TEMPLATE(BM_RenderFigureOstream, svg::Polyline);
+
+void BM_RenderDocument(benchmark::State &state) {
+  svg::Document doc;
+  for (auto &object : bench::Scene(state.range(0))) {
+    doc.Add(std::move(object));
+  }
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+    writer.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_RenderDocument)->Arg(1000)->Arg(100000)->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Same as above with a stats collector, for the measurement overhead.
+void BM_RenderDocumentStats(benchmark::State &state) {
+  svg::Document doc;
+  for (auto &object : bench::Scene(state.range(0))) {
+    doc.Add(std::move(object));
+  }
+
+  std::string out;
+  svg::RenderStats stats;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer, svg::RenderOptions{.stats = &stats});
+    writer.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_RenderDocumentStats)->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+// Measuring first and rendering into a string reserved once, against the
+// ostream render used before to learn the size. A negative precision
+// writes the shortest form.
+namespace {
+svg::RenderOptions PrecisionOptions(int64_t precision) {
+  svg::RenderOptions options;
+  if (precision >= 0) {
+    options.precision = static_cast<int>(precision);
+  }
+  return options;
+}
+}
+
+void BM_RenderedSize(benchmark::State &state) {
+  svg::Document doc;
+  for (auto &object : bench::Scene(state.range(0))) {
+    doc.Add(std::move(object));
+  }
+  auto options = PrecisionOptions(state.range(1));
+
+  uint64_t size = 0;
+  for (auto _ : state) {
+    size = doc.RenderedSize(options);
+    benchmark::DoNotOptimize(size);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_RenderedSize)->Args({100000, -1})->Args({100000, 2})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_RenderedSizeOstream(benchmark::State &state) {
+  svg::Document doc;
+  for (auto &object : bench::Scene(state.range(0))) {
+    doc.Add(std::move(object));
+  }
+
+  auto options = PrecisionOptions(state.range(1));
+
+  uint64_t size = 0;
+  for (auto _ : state) {
+    std::ostringstream ss;
+    doc.Render(ss, options);
+    size = ss.str().size();
+    benchmark::DoNotOptimize(size);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_RenderedSizeOstream)->Args({100000, -1})->Args({100000, 2})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_BuildSection(benchmark::State &state) {
+  auto scene = bench::Scene(state.range(0));
+
+  size_t allocations = 0;
+  size_t bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    svg::SectionBuilder builder;
+    for (auto &object : scene) {
+      builder.Add(object);
+    }
+    size_t before = bench::AllocationCount();
+    state.ResumeTiming();
+
+    auto section = builder.Build();
+
+    state.PauseTiming();
+    allocations += bench::AllocationCount() - before;
+    std::string out;
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    section.Render(writer);
+    writer.Flush();
+    bytes += out.size();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(bytes);
+  state.counters["allocs"] =
+      benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_BuildSection)->Arg(1000)->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,54 @@
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/escape.h"
+#include "svg/writer.h"
+
+namespace {
+// Label-sized strings, state.range(0) of every 100 containing an ampersand.
+std::vector<std::string> Labels(int dirty_percent) {
+  std::vector<std::string> labels;
+  for (int i = 0; i < 1000; ++i) {
+    std::string label = "Central Station Square " + std::to_string(i);
+    if (i % 100 < dirty_percent) {
+      label += " & Market";
+    }
+    labels.push_back(label);
+  }
+  return labels;
+}
+
+void BM_WriteRaw(benchmark::State &state) {
+  auto labels = Labels(state.range(0));
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    for (auto &label : labels) {
+      writer << label;
+    }
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_WriteRaw)->Arg(0)->Arg(10);
+
+void BM_WriteEscaped(benchmark::State &state) {
+  auto labels = Labels(state.range(0));
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    for (auto &label : labels) {
+      svg::WriteEscaped(writer, label);
+    }
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_WriteEscaped)->Arg(0)->Arg(10);
+}
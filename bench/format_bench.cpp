@@ -0,0 +1,121 @@
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/format.h"
+#include "svg/writer.h"
+
+namespace {
+std::vector<double> RandomValues(size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-10000.0, 10000.0);
+  std::vector<double> values(count);
+  for (auto &value : values) {
+    value = dist(gen);
+  }
+  return values;
+}
+
+void BM_OstreamDouble(benchmark::State &state) {
+  auto values = RandomValues(1024);
+  std::ostringstream ss;
+  for (auto _ : state) {
+    ss.str({});
+    for (double value : values) {
+      ss << value << ' ';
+    }
+    benchmark::DoNotOptimize(ss);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_OstreamDouble);
+
+void BM_FormatNumber(benchmark::State &state) {
+  auto values = RandomValues(1024);
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    for (double value : values) {
+      writer << value << ' ';
+    }
+    writer.Flush();
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_FormatNumber);
+
+void BM_FormatNumberRaw(benchmark::State &state) {
+  auto values = RandomValues(1024);
+  char buf[svg::kMaxNumberLength];
+  for (auto _ : state) {
+    for (double value : values) {
+      benchmark::DoNotOptimize(svg::FormatNumber(buf, value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_FormatNumberRaw);
+
+void BM_FormatRoundedRaw(benchmark::State &state) {
+  auto values = RandomValues(1024);
+  char buf[svg::kMaxNumberLength];
+  for (auto _ : state) {
+    for (double value : values) {
+      benchmark::DoNotOptimize(
+          svg::FormatRounded(buf, value, static_cast<int>(state.range(0))));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_FormatRoundedRaw)->Arg(0)->Arg(2)->Arg(6);
+
+void BM_RenderPolyline(benchmark::State &state) {
+  auto values = RandomValues(2 * state.range(0));
+  svg::Polyline polyline;
+  for (size_t i = 0; i < values.size(); i += 2) {
+    polyline.AddPoint({values[i], values[i + 1]});
+  }
+  svg::Document doc;
+  doc.Add(std::move(polyline));
+
+  std::ostringstream ss;
+  for (auto _ : state) {
+    ss.str({});
+    doc.Render(ss);
+    benchmark::DoNotOptimize(ss);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RenderPolyline)->Arg(1000)->Arg(100000);
+
+void BM_RenderPolylineWriter(benchmark::State &state) {
+  auto values = RandomValues(2 * state.range(0));
+  svg::Polyline polyline;
+  for (size_t i = 0; i < values.size(); i += 2) {
+    polyline.AddPoint({values[i], values[i + 1]});
+  }
+  svg::Document doc;
+  doc.Add(std::move(polyline));
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+    writer.Flush();
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RenderPolylineWriter)->Arg(1000)->Arg(100000);
+}
@@ -0,0 +1,47 @@
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/gzip_sink.h"
+#include "svg/writer.h"
+
+namespace {
+svg::Document Scene(size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  svg::Document doc;
+  for (size_t i = 0; i < count; ++i) {
+    doc.Add(svg::Circle{}.SetCenter({coord(gen), coord(gen)}).SetRadius(3));
+  }
+  return doc;
+}
+
+// Uncompressed bytes per second of rendering straight into gzip.
+void BM_RenderGzip(benchmark::State &state) {
+  auto doc = Scene(100000);
+  size_t compressed_size = 0;
+  size_t size = 0;
+  for (auto _ : state) {
+    compressed_size = 0;
+    size = 0;
+    svg::CallbackSink out([&compressed_size](std::string_view data) {
+      compressed_size += data.size();
+    });
+    svg::GzipSink gzip(out, static_cast<int>(state.range(0)));
+    svg::CallbackSink counter([&gzip, &size](std::string_view data) {
+      size += data.size();
+      gzip.Write(data);
+    });
+    svg::Writer writer(counter);
+    doc.Render(writer);
+    writer.Flush();
+    gzip.Finish();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+  state.counters["ratio"] = static_cast<double>(compressed_size) / size;
+}
+BENCHMARK(BM_RenderGzip)->Arg(1)->Arg(6)->Arg(9);
+}
@@ -0,0 +1,47 @@
+#include <random>
+#include <string>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/thread_pool.h"
+#include "svg/writer.h"
+
+namespace {
+svg::Document Routes(size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  svg::Document doc;
+  for (size_t i = 0; i < count; ++i) {
+    svg::Polyline polyline;
+    for (int j = 0; j < 20; ++j) {
+      polyline.AddPoint({coord(gen), coord(gen)});
+    }
+    doc.Add(std::move(polyline));
+  }
+  return doc;
+}
+
+void BM_RenderThreads(benchmark::State &state) {
+  auto doc = Routes(100000);
+  svg::ThreadPool pool(state.range(0));
+  svg::RenderOptions options{.threads = static_cast<size_t>(state.range(0)),
+                             .executor = &pool};
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer, options);
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_RenderThreads)
+    ->DenseRange(1, std::thread::hardware_concurrency(), 1)
+    ->UseRealTime();
+}
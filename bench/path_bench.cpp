@@ -0,0 +1,59 @@
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "scene.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/writer.h"
+
+namespace {
+constexpr size_t kRoutes = 1000;
+
+// Routes of the bench scene, with full precision coordinates or rounded to
+// 2 decimals like most real data.
+svg::Document Routes(bool rounded) {
+  svg::Document doc;
+  for (auto &polyline : bench::Figures<svg::Polyline>(kRoutes)) {
+    if (!rounded) {
+      doc.Add(std::move(polyline));
+      continue;
+    }
+    svg::Polyline copy;
+    for (auto point : polyline.GetPoints()) {
+      copy.AddPoint({std::round(point.x * 100) / 100,
+                     std::round(point.y * 100) / 100});
+    }
+    auto &style = polyline.GetStyle();
+    doc.Add(copy.SetStrokeColor(style.stroke_color)
+                .SetStrokeWidth(style.stroke_width)
+                .SetStrokeLineCap(style.linecap)
+                .SetStrokeLineJoin(style.linejoin));
+  }
+  return doc;
+}
+
+// Routes written as polylines or as paths. The bytes counter is the size of
+// one render.
+void BM_RenderRoutes(benchmark::State &state) {
+  auto doc = Routes(state.range(1) != 0);
+  svg::RenderOptions options{.polylines_as_paths = state.range(0) != 0};
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer, options);
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+  state.counters["bytes"] = static_cast<double>(out.size());
+}
+BENCHMARK(BM_RenderRoutes)->ArgNames({"paths", "rounded"})
+    ->ArgsProduct({{0, 1}, {0, 1}})->Unit(benchmark::kMillisecond);
+}
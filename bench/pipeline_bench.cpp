@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "scene.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/pipeline_sink.h"
+#include "svg/writer.h"
+
+namespace {
+// Blocks like a disk or socket taking about 256 MB/s, near the formatting
+// speed, which is where overlapping the two pays off most.
+class SlowSink final : public svg::Sink {
+ public:
+  void Write(std::string_view data) override {
+    std::this_thread::sleep_for(std::chrono::microseconds(data.size() / 256));
+    size_ += data.size();
+  }
+  size_t Size() const {
+    return size_;
+  }
+
+ private:
+  size_t size_ = 0;
+};
+
+// Argument 0 renders straight into the slow sink, 1 through a pipeline.
+void BM_RenderSlowSink(benchmark::State &state) {
+  svg::Document doc;
+  for (auto &object : bench::Scene(100000)) {
+    doc.Add(std::move(object));
+  }
+
+  size_t size = 0;
+  for (auto _ : state) {
+    SlowSink sink;
+    if (state.range(0) == 0) {
+      svg::Writer writer(sink);
+      doc.Render(writer);
+      writer.Flush();
+    } else {
+      svg::PipelineSink pipeline(sink);
+      svg::Writer writer(pipeline);
+      doc.Render(writer);
+      writer.Flush();
+      pipeline.Finish();
+    }
+    size = sink.Size();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_RenderSlowSink)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+}
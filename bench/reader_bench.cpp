@@ -0,0 +1,49 @@
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "scene.h"
+#include "svg/document.h"
+#include "svg/reader.h"
+#include "svg/render_options.h"
+#include "svg/writer.h"
+
+namespace {
+constexpr size_t kObjects = 100000;
+
+std::string RenderScene(bool deduplicate_styles) {
+  svg::Document doc;
+  for (auto &object : bench::Scene(kObjects)) {
+    doc.Add(std::move(object));
+  }
+  std::string out;
+  svg::StringSink sink(out);
+  svg::Writer writer(sink);
+  doc.Render(writer, {.deduplicate_styles = deduplicate_styles});
+  writer.Flush();
+  return out;
+}
+
+void BM_ReadDocument(benchmark::State &state) {
+  auto svg = RenderScene(state.range(0) != 0);
+  for (auto _ : state) {
+    auto doc = svg::ReadDocument(svg);
+    benchmark::DoNotOptimize(doc);
+  }
+  state.SetBytesProcessed(state.iterations() * svg.size());
+  state.SetItemsProcessed(state.iterations() * kObjects);
+}
+BENCHMARK(BM_ReadDocument)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+void BM_ReadSection(benchmark::State &state) {
+  auto svg = RenderScene(false);
+  for (auto _ : state) {
+    auto section = svg::ReadSection(svg);
+    benchmark::DoNotOptimize(section);
+  }
+  state.SetBytesProcessed(state.iterations() * svg.size());
+  state.SetItemsProcessed(state.iterations() * kObjects);
+}
+BENCHMARK(BM_ReadSection)->Unit(benchmark::kMillisecond);
+}
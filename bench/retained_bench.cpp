@@ -0,0 +1,70 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/retained_document.h"
+#include "svg/writer.h"
+
+namespace {
+constexpr size_t kObjects = 200000;
+constexpr size_t kChangesPerTick = 300;
+
+// One tick of a live map: a few vehicles move, then the scene is rendered.
+void BM_TickDocument(benchmark::State &state) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  std::vector<svg::Circle> vehicles(kObjects);
+  for (auto &vehicle : vehicles) {
+    vehicle.SetCenter({coord(gen), coord(gen)}).SetRadius(3);
+  }
+
+  std::string out;
+  for (auto _ : state) {
+    for (size_t i = 0; i < kChangesPerTick; ++i) {
+      vehicles[gen() % kObjects].SetCenter({coord(gen), coord(gen)});
+    }
+    svg::Document doc;
+    for (auto &vehicle : vehicles) {
+      doc.Add(vehicle);
+    }
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_TickDocument);
+
+void BM_TickRetained(benchmark::State &state) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  svg::RetainedDocument doc;
+  for (size_t i = 0; i < kObjects; ++i) {
+    doc.Add(svg::Circle{}.SetCenter({coord(gen), coord(gen)}).SetRadius(3));
+  }
+
+  std::string out;
+  for (auto _ : state) {
+    for (size_t i = 0; i < kChangesPerTick; ++i) {
+      svg::Point center{coord(gen), coord(gen)};
+      doc.Modify<svg::Circle>(gen() % kObjects, [center](svg::Circle &circle) {
+        circle.SetCenter(center);
+      });
+    }
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_TickRetained);
+}
@@ -0,0 +1,124 @@
+#include "scene.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "svg/common.h"
+#include "svg/figures.h"
+
+namespace bench {
+namespace {
+constexpr const char *kColors[] = {"white", "black", "red", "green", "blue"};
+constexpr const char *kWords[] = {"Central", "Station", "Park", "Square",
+                                  "Market", "Bridge", "Harbour", "Street"};
+
+class Generator {
+ public:
+  explicit Generator(uint32_t seed) : gen_(seed) {}
+
+  svg::Point NextPoint() {
+    return {coord_(gen_), coord_(gen_)};
+  }
+  const char *NextColor() {
+    return kColors[gen_() % std::size(kColors)];
+  }
+
+  svg::Circle NextCircle() {
+    return svg::Circle{}.SetCenter(NextPoint()).SetRadius(3)
+        .SetFillColor(NextColor());
+  }
+  svg::Polyline NextPolyline() {
+    svg::Polyline polyline;
+    svg::Point point = NextPoint();
+    size_t count = 2 + gen_() % 30;
+    polyline.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      polyline.AddPoint(point);
+      point.x += step_(gen_);
+      point.y += step_(gen_);
+    }
+    return polyline.SetStrokeColor(NextColor()).SetStrokeWidth(2)
+        .SetStrokeLineCap("round").SetStrokeLineJoin("round");
+  }
+  svg::Text NextText() {
+    std::string data = kWords[gen_() % std::size(kWords)];
+    data += ' ';
+    data += kWords[gen_() % std::size(kWords)];
+    return svg::Text{}.SetPoint(NextPoint()).SetOffset({7, -3})
+        .SetFontSize(13).SetFontFamily("Verdana").SetData(data)
+        .SetFillColor("black");
+  }
+  svg::Rectangle NextRectangle() {
+    return svg::Rectangle{}.SetPoint(NextPoint()).SetWidth(40).SetHeight(20)
+        .SetFillColor(svg::Rgba{255, 255, 255, 0.85});
+  }
+
+  // 50% circles, 30% polylines, 15% text and 5% rectangles.
+  svg::Object NextObject() {
+    auto kind = gen_() % 20;
+    if (kind < 10) {
+      return NextCircle();
+    } else if (kind < 16) {
+      return NextPolyline();
+    } else if (kind < 19) {
+      return NextText();
+    }
+    return NextRectangle();
+  }
+
+ private:
+  std::mt19937 gen_;
+  std::uniform_real_distribution<double> coord_{0, 10000};
+  std::uniform_real_distribution<double> step_{-50, 50};
+};
+
+template<typename FigureType>
+FigureType Next(Generator &generator);
+
+template<>
+svg::Circle Next(Generator &generator) {
+  return generator.NextCircle();
+}
+template<>
+svg::Polyline Next(Generator &generator) {
+  return generator.NextPolyline();
+}
+template<>
+svg::Text Next(Generator &generator) {
+  return generator.NextText();
+}
+template<>
+svg::Rectangle Next(Generator &generator) {
+  return generator.NextRectangle();
+}
+}
+
+std::vector<svg::Object> Scene(size_t count, uint32_t seed) {
+  Generator generator(seed);
+  std::vector<svg::Object> objects;
+  objects.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    objects.push_back(generator.NextObject());
+  }
+  return objects;
+}
+
+template<typename FigureType>
+std::vector<FigureType> Figures(size_t count, uint32_t seed) {
+  Generator generator(seed);
+  std::vector<FigureType> figures;
+  figures.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    figures.push_back(Next<FigureType>(generator));
+  }
+  return figures;
+}
+
+template std::vector<svg::Circle> Figures(size_t, uint32_t);
+template std::vector<svg::Polyline> Figures(size_t, uint32_t);
+template std::vector<svg::Text> Figures(size_t, uint32_t);
+template std::vector<svg::Rectangle> Figures(size_t, uint32_t);
+}
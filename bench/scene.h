@@ -0,0 +1,23 @@
+#ifndef SVG_BENCH_SCENE_H_
+#define SVG_BENCH_SCENE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "svg/figures.h"
+
+namespace bench {
+constexpr uint32_t kSceneSeed = 42;
+
+// Map-like synthetic scene over a 10000 x 10000 area: mostly circles and
+// short polylines with some labels and rectangles, in a few styles. The
+// same seed always gives the same objects.
+std::vector<svg::Object> Scene(size_t count, uint32_t seed = kSceneSeed);
+
+// Objects of a single figure type generated the same way.
+template<typename FigureType>
+std::vector<FigureType> Figures(size_t count, uint32_t seed = kSceneSeed);
+}
+
+#endif // SVG_BENCH_SCENE_H_
@@ -0,0 +1,55 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/writer.h"
+
+namespace {
+// A multi-megabyte map background.
+svg::Section Background() {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  svg::SectionBuilder builder;
+  for (int i = 0; i < 20000; ++i) {
+    svg::Polyline polyline;
+    for (int j = 0; j < 10; ++j) {
+      polyline.AddPoint({coord(gen), coord(gen)});
+    }
+    builder.Add(std::move(polyline));
+  }
+  return builder.Build();
+}
+
+void BM_ComposeSection(benchmark::State &state) {
+  auto background = Background();
+  for (auto _ : state) {
+    auto section = svg::SectionBuilder{}
+        .Add(background)
+        .Add(svg::Circle{}.SetCenter({5, 5}))
+        .Build();
+    benchmark::DoNotOptimize(section);
+  }
+}
+BENCHMARK(BM_ComposeSection);
+
+void BM_RenderSectionToFd(benchmark::State &state) {
+  svg::Document doc;
+  doc.Add(Background());
+  doc.Add(svg::Circle{});
+
+  int fd = open("/dev/null", O_WRONLY);
+  for (auto _ : state) {
+    svg::FdSink sink(fd);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+    writer.Flush();
+  }
+  close(fd);
+}
+BENCHMARK(BM_RenderSectionToFd);
+}
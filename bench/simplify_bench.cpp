@@ -0,0 +1,53 @@
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/simplify.h"
+#include "svg/writer.h"
+
+namespace {
+// A GPS-like trace: a smooth curve with small jitter on every vertex.
+svg::Polyline Trace(size_t count) {
+  std::mt19937 gen(42);
+  std::normal_distribution<double> jitter(0.0, 0.01);
+  svg::Polyline polyline;
+  polyline.Reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    double t = static_cast<double>(i) / count;
+    polyline.AddPoint({1000 * t + jitter(gen),
+                       200 * std::sin(12 * t) + jitter(gen)});
+  }
+  return polyline;
+}
+
+void BM_RenderTrace(benchmark::State &state) {
+  svg::Document doc;
+  doc.Add(Trace(state.range(1)));
+
+  svg::RenderOptions options;
+  if (state.range(0) >= 0) {
+    options.simplification = svg::Simplification{
+        .algorithm = static_cast<svg::SimplifyAlgorithm>(state.range(0)),
+        .tolerance = 0.5};
+  }
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer, options);
+    writer.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+  state.counters["output_bytes"] = out.size();
+}
+BENCHMARK(BM_RenderTrace)
+    ->ArgNames({"algorithm", "points"})
+    ->ArgsProduct({{-1, 0, 1}, {100000}});
+}
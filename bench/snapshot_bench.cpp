@@ -0,0 +1,63 @@
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "scene.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/snapshot.h"
+#include "svg/writer.h"
+
+namespace {
+constexpr size_t kObjects = 1000000;
+
+void BM_BuildDocument(benchmark::State &state) {
+  auto scene = bench::Scene(kObjects);
+  for (auto _ : state) {
+    svg::Document doc;
+    for (auto &object : scene) {
+      doc.Add(object);
+    }
+    benchmark::DoNotOptimize(doc);
+  }
+  state.SetItemsProcessed(state.iterations() * kObjects);
+}
+BENCHMARK(BM_BuildDocument)->Unit(benchmark::kMillisecond);
+
+// Cold start from a snapshot: map, validate and render once.
+void BM_OpenAndRenderSnapshot(benchmark::State &state) {
+  std::string path = "/tmp/svg_snapshot_bench_XXXXXX";
+  int fd = mkstemp(path.data());
+  {
+    svg::Document doc;
+    for (auto &object : bench::Scene(kObjects)) {
+      doc.Add(std::move(object));
+    }
+    svg::FdSink sink(fd);
+    svg::SaveSnapshot(doc, sink);
+  }
+
+  std::string out;
+  for (auto _ : state) {
+    auto snapshot = svg::Snapshot::Open(path);
+    state.PauseTiming();
+    out.clear();
+    state.ResumeTiming();
+    if (state.range(0) != 0) {
+      svg::StringSink sink(out);
+      svg::Writer writer(sink);
+      snapshot.Render(writer);
+    }
+    benchmark::DoNotOptimize(snapshot);
+  }
+  state.SetItemsProcessed(state.iterations() * kObjects);
+  close(fd);
+  unlink(path.c_str());
+}
+BENCHMARK(BM_OpenAndRenderSnapshot)->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,59 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/writer.h"
+
+namespace {
+// A map layer: stops and roads drawn with a dozen recurring styles.
+svg::Document Map(size_t count) {
+  std::vector<svg::Color> palette{"red", "green", svg::Rgb{20, 40, 60},
+                                  svg::Rgba{200, 100, 50, 0.85}, "black",
+                                  "white"};
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  svg::Document doc;
+  for (size_t i = 0; i < count; ++i) {
+    auto &color = palette[i % palette.size()];
+    if (i % 2 == 0) {
+      doc.Add(svg::Circle{}
+                  .SetCenter({coord(gen), coord(gen)})
+                  .SetRadius(5)
+                  .SetFillColor(color)
+                  .SetStrokeColor("black"));
+    } else {
+      doc.Add(svg::Polyline{}
+                  .AddPoint({coord(gen), coord(gen)})
+                  .AddPoint({coord(gen), coord(gen)})
+                  .SetStrokeColor(color)
+                  .SetStrokeWidth(14)
+                  .SetStrokeLineCap("round")
+                  .SetStrokeLineJoin("round"));
+    }
+  }
+  return doc;
+}
+
+void BM_RenderMap(benchmark::State &state) {
+  auto doc = Map(100000);
+  svg::RenderOptions options{.deduplicate_styles = state.range(0) != 0};
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer, options);
+    writer.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * 100000);
+  state.counters["output_bytes"] = out.size();
+}
+BENCHMARK(BM_RenderMap)->ArgName("deduplicate")->Arg(0)->Arg(1);
+}
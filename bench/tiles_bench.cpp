@@ -0,0 +1,75 @@
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "scene.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/tiles.h"
+#include "svg/writer.h"
+
+namespace {
+constexpr size_t kObjects = 100000;
+
+// The scene covers 10000 x 10000, split into range(0) squared tiles.
+svg::TileGrid Grid(size_t side) {
+  double size = 10000.0 / static_cast<double>(side);
+  return svg::TileGrid{.tile_width = size, .tile_height = size,
+                       .columns = side, .rows = side};
+}
+
+void BM_RenderTiles(benchmark::State &state) {
+  svg::Document doc;
+  for (auto &object : bench::Scene(kObjects)) {
+    doc.Add(std::move(object));
+  }
+  auto grid = Grid(state.range(0));
+
+  size_t size = 0;
+  svg::CallbackSink sink([&size](std::string_view data) {
+    size += data.size();
+  });
+  for (auto _ : state) {
+    svg::RenderTiles(doc, grid, [&sink](size_t, size_t) -> svg::Sink & {
+      return sink;
+    });
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(size));
+}
+BENCHMARK(BM_RenderTiles)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+// What RenderTiles replaces: a document built for every tile from the
+// objects touching it, positions left untranslated.
+void BM_BuildTileDocuments(benchmark::State &state) {
+  auto objects = bench::Scene(kObjects);
+  auto grid = Grid(state.range(0));
+
+  size_t size = 0;
+  svg::CallbackSink sink([&size](std::string_view data) {
+    size += data.size();
+  });
+  for (auto _ : state) {
+    for (size_t row = 0; row < grid.rows; ++row) {
+      for (size_t column = 0; column < grid.columns; ++column) {
+        auto tile = grid.TileBounds(column, row);
+        svg::Document doc;
+        for (auto &object : objects) {
+          if (svg::Bounds(object).Intersects(tile)) {
+            doc.Add(object);
+          }
+        }
+        svg::Writer writer(sink);
+        doc.Render(writer);
+      }
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(size));
+}
+BENCHMARK(BM_BuildTileDocuments)->Arg(4)->Arg(16)
+    ->Unit(benchmark::kMillisecond);
+}
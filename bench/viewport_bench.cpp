@@ -0,0 +1,60 @@
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/writer.h"
+
+namespace {
+// City-scale layer: many small circles spread over a 10000 x 10000 area.
+svg::Document City(size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coord(0, 10000);
+  svg::Document doc;
+  for (size_t i = 0; i < count; ++i) {
+    doc.Add(svg::Circle{}.SetCenter({coord(gen), coord(gen)}).SetRadius(3));
+  }
+  return doc;
+}
+
+void BM_RenderViewport(benchmark::State &state) {
+  auto doc = City(state.range(0));
+  svg::RenderOptions options;
+  options.viewport = svg::Box{{5000, 5000}, {5500, 5500}};
+
+  // The index is built lazily on the first viewport render.
+  std::string out;
+  {
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer, options);
+  }
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer, options);
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_RenderViewport)->Arg(10000)->Arg(1000000);
+
+void BM_RenderFull(benchmark::State &state) {
+  auto doc = City(state.range(0));
+
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+    writer.Flush();
+  }
+  state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_RenderFull)->Arg(10000)->Arg(1000000);
+}
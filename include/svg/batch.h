@@ -0,0 +1,47 @@
+#ifndef SVG_BATCH_H_
+#define SVG_BATCH_H_
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <vector>
+
+#include "document.h"
+#include "render_options.h"
+#include "writer.h"
+
+namespace svg {
+// Documents with fewer objects are packed together into tasks of about
+// this many objects, larger ones are split into chunks.
+inline constexpr size_t kBatchTaskObjects = 4096;
+
+// Document to render and the sink its output goes to.
+struct BatchItem {
+  const Document *document;
+  Sink *sink;
+};
+
+// Called once per document as soon as its output is flushed, with its
+// position in the batch and the exception it failed with, if any. Calls
+// come from the rendering threads, one at a time. An exception it throws
+// does not stop the batch, the first one is rethrown once it is done.
+using BatchCallback =
+    std::function<void(size_t index, std::exception_ptr error)>;
+
+// Renders every document to its own sink with the options, on
+// options.threads threads of options.executor or of ThreadPool::Shared.
+// Small documents are packed into shared tasks and large ones are
+// formatted in parallel chunks, so all threads stay busy whatever the
+// sizes; every thread formats into one writer buffer it reuses for all its
+// documents. A failing document does not stop the others: its error goes
+// to on_done, or without one the first error is rethrown once the whole
+// batch is done. Stats, when given, collect the whole batch.
+void RenderBatch(const BatchItem *items, size_t count,
+                 const RenderOptions &options,
+                 const BatchCallback &on_done = {});
+void RenderBatch(const std::vector<BatchItem> &items,
+                 const RenderOptions &options,
+                 const BatchCallback &on_done = {});
+}
+
+#endif // SVG_BATCH_H_
@@ -1,17 +1,53 @@
 #ifndef SVG_COMMON_H_
 #define SVG_COMMON_H_
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <ostream>
 #include <string>
 #include <variant>
 
+#include "writer.h"
+
 namespace svg {
 struct Point {
   double x = 0.0;
   double y = 0.0;
 };
 
+// Axis-aligned bounding box, a default constructed box is empty.
+struct Box {
+  Point min{std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::infinity()};
+  Point max{-std::numeric_limits<double>::infinity(),
+            -std::numeric_limits<double>::infinity()};
+
+  bool Empty() const {
+    return min.x > max.x || min.y > max.y;
+  }
+
+  Box &Extend(Point point) {
+    min.x = std::min(min.x, point.x);
+    min.y = std::min(min.y, point.y);
+    max.x = std::max(max.x, point.x);
+    max.y = std::max(max.y, point.y);
+    return *this;
+  }
+  Box &Extend(const Box &box) {
+    if (!box.Empty()) {
+      Extend(box.min);
+      Extend(box.max);
+    }
+    return *this;
+  }
+
+  bool Intersects(const Box &other) const {
+    return min.x <= other.max.x && other.min.x <= max.x &&
+        min.y <= other.max.y && other.min.y <= max.y;
+  }
+};
+
 struct Rgb {
   uint8_t red = 0;
   uint8_t green = 0;
@@ -25,9 +61,19 @@ struct Rgba {
   double alpha = 1.0;
 };
 
+inline bool operator==(const Rgb &lhs, const Rgb &rhs) {
+  return lhs.red == rhs.red && lhs.green == rhs.green && lhs.blue == rhs.blue;
+}
+
+inline bool operator==(const Rgba &lhs, const Rgba &rhs) {
+  return lhs.red == rhs.red && lhs.green == rhs.green &&
+      lhs.blue == rhs.blue && lhs.alpha == rhs.alpha;
+}
+
 using Color = std::variant<std::monostate, std::string, Rgb, Rgba>;
 
 std::ostream &operator<<(std::ostream &out, const Color &col);
+Writer &operator<<(Writer &out, const Color &col);
 
 static const Color kNoneColor;
 }
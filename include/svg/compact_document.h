@@ -0,0 +1,108 @@
+#ifndef SVG_COMPACT_DOCUMENT_H_
+#define SVG_COMPACT_DOCUMENT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common.h"
+#include "figures.h"
+#include "render_options.h"
+#include "render_stats.h"
+#include "simplify.h"
+#include "style.h"
+#include "writer.h"
+
+namespace svg {
+class SpatialIndex;
+struct StyleIndex;
+
+// Document keeping every figure type in its own dense arrays instead of a
+// vector of Object, whose elements are all as large as the largest figure.
+// Styles are stored once in a table and referred to by number, circle and
+// rectangle fields live in parallel arrays and polylines share one point
+// array, as do paths. A draw-order index of 4 bytes per object keeps the
+// order objects were added in. The output is the same as of Document. Add
+// throws std::length_error past 2^29 objects of one figure type.
+class CompactDocument final {
+ public:
+  void Add(const Circle &circle);
+  void Add(const Polyline &polyline);
+  void Add(const Text &text);
+  void Add(const Rectangle &rectangle);
+  void Add(const Path &path);
+  void Add(const Section &section);
+  void Add(const Object &object);
+  size_t Size() const;
+
+  void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
+  void Render(std::ostream &out, const RenderOptions &options) const;
+  void Render(Writer &out, const RenderOptions &options) const;
+  // Bytes Render writes with these options, exact and without keeping them.
+  uint64_t RenderedSize(const RenderOptions &options = {}) const;
+
+ private:
+  // Draw-order entries hold the figure type in the top bits and the
+  // position in the arrays of that type in the rest.
+  enum Kind : uint32_t {
+    kCircle,
+    kPolyline,
+    kText,
+    kRectangle,
+    kPath,
+    kSection,
+  };
+  static constexpr uint32_t kKindShift = 29;
+  static constexpr uint32_t kPositionMask = (uint32_t{1} << kKindShift) - 1;
+
+  void AddEntry(Kind kind, size_t position);
+  uint32_t AddStyle(const Style &style);
+  const Style *StyleOf(size_t i) const;
+  Box BoundsOf(size_t i) const;
+  void RenderEntry(Writer &out, size_t i, const RenderOptions &options,
+                   RenderStats *stats) const;
+  // Built on the first viewport render, dropped by Add.
+  std::shared_ptr<const SpatialIndex> Index() const;
+
+  std::vector<uint32_t> order_;
+
+  std::vector<Style> styles_;
+  std::unordered_map<Style, uint32_t, StyleHash> style_ids_;
+
+  std::vector<Point> circle_centers_;
+  std::vector<double> circle_radii_;
+  std::vector<uint32_t> circle_styles_;
+
+  std::vector<Point> points_;
+  // End of the points of each polyline in points_.
+  std::vector<size_t> polyline_ends_;
+  std::vector<uint32_t> polyline_styles_;
+  // Own simplifications of the few polylines having one, by position.
+  std::vector<std::pair<uint32_t, Simplification>> simplifications_;
+
+  std::vector<Point> rectangle_points_;
+  std::vector<double> rectangle_widths_;
+  std::vector<double> rectangle_heights_;
+  std::vector<uint32_t> rectangle_styles_;
+
+  std::vector<Path::Command> path_commands_;
+  std::vector<Point> path_points_;
+  // Ends of the commands and of the points of each path.
+  std::vector<size_t> path_command_ends_;
+  std::vector<size_t> path_point_ends_;
+  std::vector<uint32_t> path_styles_;
+
+  std::vector<Text> texts_;
+  std::vector<Section> sections_;
+
+  mutable std::shared_ptr<const SpatialIndex> index_;
+  mutable std::shared_ptr<const StyleIndex> style_index_;
+};
+}
+
+#endif // SVG_COMPACT_DOCUMENT_H_
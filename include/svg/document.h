@@ -1,22 +1,79 @@
 #ifndef SVG_DOCUMENT_H_
 #define SVG_DOCUMENT_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
+#include <stdexcept>
 #include <vector>
 
+#include "common.h"
 #include "figures.h"
+#include "render_options.h"
+#include "writer.h"
 
 namespace svg {
+class SpatialIndex;
+struct StyleIndex;
+
+// Objects and the storage they own come from the document's memory
+// resource, so a document backed by an arena frees everything at once.
 class Document final {
  public:
   Document() = default;
+  explicit Document(std::pmr::memory_resource *resource);
 
   void Add(const Object &object);
   void Add(Object &&object);
+  size_t Size() const;
+  const Object &Get(size_t i) const;
   void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
+  void Render(std::ostream &out, const RenderOptions &options) const;
+  void Render(Writer &out, const RenderOptions &options) const;
+  // Bytes Render writes with these options, exact and without keeping them.
+  uint64_t RenderedSize(const RenderOptions &options = {}) const;
+  // Builds the spatial index of viewport renders ahead of them, e.g. before
+  // rendering tiles concurrently. Otherwise built by the first one.
+  void BuildIndex() const;
+
+ private:
+  // Built on the first viewport render or by BuildIndex, dropped by Add.
+  std::shared_ptr<const SpatialIndex> Index() const;
+
+  std::pmr::vector<Object> objects_;
+  mutable std::shared_ptr<const SpatialIndex> index_;
+  // Built on the first render with deduplicated styles, dropped by Add.
+  mutable std::shared_ptr<const StyleIndex> style_index_;
+};
+
+// Writes objects to the writer as soon as they are added instead of storing
+// them, so memory use does not depend on the document size. The prologue is
+// written on construction and the closing tag by Finish or the destructor.
+class StreamingDocument final {
+ public:
+  explicit StreamingDocument(Writer &out);
+  StreamingDocument(const StreamingDocument &) = delete;
+  StreamingDocument &operator=(const StreamingDocument &) = delete;
+  ~StreamingDocument();
+
+  // Throws std::logic_error after Finish, the closing tag is written.
+  template<typename FigureType>
+  StreamingDocument &Add(const FigureType &figure) {
+    if (finished_) {
+      throw std::logic_error("svg::StreamingDocument: Add after Finish");
+    }
+    figure.Render(out_);
+    return *this;
+  }
+  StreamingDocument &Add(const Object &object);
+  void Finish();
 
  private:
-  std::vector<Object> objects_;
+  Writer &out_;
+  bool finished_ = false;
 };
 }
 
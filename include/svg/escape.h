@@ -0,0 +1,24 @@
+#ifndef SVG_ESCAPE_H_
+#define SVG_ESCAPE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "writer.h"
+
+namespace svg {
+// Position of the first of & < > " ' in data, or data.size() if there is
+// none. Scans 16 bytes at a time where SSE2 is available.
+size_t FindSpecialChar(std::string_view data);
+
+// Writes data with & < > " ' replaced by character references, so it is
+// valid both as element content and inside an attribute value. Runs
+// without special characters are copied in bulk.
+void WriteEscaped(Writer &out, std::string_view data);
+std::string Escape(std::string_view data);
+// Reverses Escape, other references are left as they are.
+std::string Unescape(std::string_view data);
+}
+
+#endif // SVG_ESCAPE_H_
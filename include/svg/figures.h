@@ -1,24 +1,38 @@
 #ifndef SVG_FIGURES_H_
 #define SVG_FIGURES_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include "common.h"
+#include "property.h"
+#include "render_stats.h"
+#include "simplify.h"
+#include "style.h"
+#include "writer.h"
 
 namespace svg {
 class Circle;
 class Polyline;
 class Text;
 class Rectangle;
+class Path;
 class Section;
-using Object = std::variant<Circle, Polyline, Text, Rectangle, Section>;
+using Object =
+    std::variant<Circle, Polyline, Text, Rectangle, Path, Section>;
+
+// Bounding box of everything the object draws, including the stroke. Text
+// extents are estimated as one em per character.
+Box Bounds(const Object &object);
 
 template<typename FigureType>
 class Figure {
@@ -26,151 +40,314 @@ class Figure {
   Figure() = default;
 
   FigureType &SetFillColor(const Color &color) {
-    fill_color_ = color;
-    return *static_cast<FigureType *>(this);
+    return SetFillColor(Property::Intern(color));
   }
-  FigureType &SetFillColor(Color &&color) {
-    fill_color_ = std::move(color);
+  FigureType &SetFillColor(Property color) {
+    style_.fill_color = color;
     return *static_cast<FigureType *>(this);
   }
 
   FigureType &SetStrokeColor(const Color &color) {
-    stroke_color_ = color;
-    return *static_cast<FigureType *>(this);
+    return SetStrokeColor(Property::Intern(color));
   }
-  FigureType &SetStrokeColor(Color &&color) {
-    stroke_color_ = std::move(color);
+  FigureType &SetStrokeColor(Property color) {
+    style_.stroke_color = color;
     return *static_cast<FigureType *>(this);
   }
 
   FigureType &SetStrokeWidth(double width) {
-    stroke_width_ = width;
+    style_.stroke_width = width;
     return *static_cast<FigureType *>(this);
   }
 
-  FigureType &SetStrokeLineCap(const std::string &linecap) {
-    linecap_ = linecap;
-    return *static_cast<FigureType *>(this);
+  FigureType &SetStrokeLineCap(std::string_view linecap) {
+    return SetStrokeLineCap(Property::Intern(linecap));
   }
-  FigureType &SetStrokeLineCap(std::string &&linecap) {
-    linecap_ = std::move(linecap);
+  FigureType &SetStrokeLineCap(Property linecap) {
+    style_.linecap = linecap;
     return *static_cast<FigureType *>(this);
   }
 
-  FigureType &SetStrokeLineJoin(const std::string &linejoin) {
-    linejoin_ = linejoin;
-    return *static_cast<FigureType *>(this);
+  FigureType &SetStrokeLineJoin(std::string_view linejoin) {
+    return SetStrokeLineJoin(Property::Intern(linejoin));
   }
-  FigureType &SetStrokeLineJoin(std::string &&linejoin) {
-    linejoin_ = std::move(linejoin);
+  FigureType &SetStrokeLineJoin(Property linejoin) {
+    style_.linejoin = linejoin;
     return *static_cast<FigureType *>(this);
   }
 
- protected:
-  void RenderProperties(std::ostream &out) const {
-    out << "fill=\"" << fill_color_ << "\" " <<
-        "stroke=\"" << stroke_color_ << "\" " <<
-        "stroke-width=\"" << stroke_width_ << "\" ";
-    if (linecap_.has_value())
-      out << "stroke-linecap=\"" << *linecap_ << "\" ";
-    if (linejoin_.has_value())
-      out << "stroke-linejoin=\"" << *linejoin_ << "\" ";
+  const Style &GetStyle() const {
+    return style_;
+  }
+
+  // Bytes Render writes, counted without keeping them. Pass the writer the
+  // figure goes to for its format settings, such as the precision.
+  uint64_t RenderedSize() const {
+    auto out = Writer::Measuring();
+    static_cast<const FigureType *>(this)->Render(out);
+    return out.BytesWritten();
+  }
+  uint64_t RenderedSize(const Writer &format) const {
+    auto out = Writer::Measuring();
+    out.CopyFormat(format);
+    static_cast<const FigureType *>(this)->Render(out);
+    return out.BytesWritten();
   }
 
  private:
-  Color fill_color_;
-  Color stroke_color_;
-  double stroke_width_ = 1.0;
-  std::optional<std::string> linecap_;
-  std::optional<std::string> linejoin_;
+  Style style_;
 };
 
 class Circle final : public Figure<Circle> {
  public:
+  friend class CompactDocument;
   Circle() = default;
 
+  Box Bounds() const;
   void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
 
   Circle &SetCenter(Point center);
   Circle &SetRadius(double radius);
 
+  Point GetCenter() const {
+    return center_;
+  }
+  double GetRadius() const {
+    return radius_;
+  }
+
  private:
   Point center_;
   double radius_ = 1.0;
 };
 
+// Figures owning memory are allocator-aware: Document and SectionBuilder
+// move them to their memory resource when they are added.
+using Allocator = std::pmr::polymorphic_allocator<std::byte>;
+
 class Polyline final : public Figure<Polyline> {
  public:
-  Polyline() = default;
+  friend class CompactDocument;
+  using allocator_type = Allocator;
 
+  Polyline() = default;
+  explicit Polyline(const allocator_type &alloc);
+  Polyline(const Polyline &other) = default;
+  Polyline(Polyline &&other) = default;
+  Polyline(const Polyline &other, const allocator_type &alloc);
+  Polyline(Polyline &&other, const allocator_type &alloc);
+  Polyline &operator=(const Polyline &other) = default;
+  Polyline &operator=(Polyline &&other) = default;
+
+  Box Bounds() const;
   void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
+  // Uses fallback unless the polyline has its own simplification. Returns
+  // the number of points written.
+  size_t Render(Writer &out,
+                const std::optional<Simplification> &fallback) const;
 
   Polyline &AddPoint(Point point);
+  // Bulk versions of AddPoint, they reallocate the storage at most once.
+  Polyline &AddPoints(const Point *points, size_t count);
+  Polyline &AddPoints(const std::vector<Point> &points);
+  Polyline &AddPoints(const double *xs, const double *ys, size_t count);
+  // Preallocates storage for count points in total.
+  Polyline &Reserve(size_t count);
+  // Simplifies the points while rendering, the stored points are unchanged.
+  Polyline &SetSimplification(Simplification simplification);
+
+  const std::pmr::vector<Point> &GetPoints() const {
+    return points_;
+  }
+  const std::optional<Simplification> &GetSimplification() const {
+    return simplification_;
+  }
 
  private:
-  std::vector<Point> points_;
+  std::pmr::vector<Point> points_;
+  std::optional<Simplification> simplification_;
 };
 
 class Text final : public Figure<Text> {
  public:
-  Text() = default;
+  using allocator_type = Allocator;
 
+  Text() = default;
+  explicit Text(const allocator_type &alloc);
+  Text(const Text &other) = default;
+  Text(Text &&other) = default;
+  Text(const Text &other, const allocator_type &alloc);
+  Text(Text &&other, const allocator_type &alloc);
+  Text &operator=(const Text &other) = default;
+  Text &operator=(Text &&other) = default;
+
+  Box Bounds() const;
   void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
 
   Text &SetPoint(Point point);
   Text &SetOffset(Point offset);
   Text &SetFontSize(uint32_t font_size);
-  Text &SetFontFamily(const std::string &font_family);
-  Text &SetFontFamily(std::string &&font_family);
-  Text &SetFontWeight(const std::string &font_weight);
-  Text &SetFontWeight(std::string &&font_weight);
+  Text &SetFontFamily(std::string_view font_family);
+  Text &SetFontFamily(Property font_family);
+  Text &SetFontWeight(std::string_view font_weight);
+  Text &SetFontWeight(Property font_weight);
+  Text &SetData(std::string_view text);
+  Text &SetData(const char *text);
   Text &SetData(const std::string &text);
   Text &SetData(std::string &&text);
 
+  Point GetPoint() const {
+    return coords_;
+  }
+  Point GetOffset() const {
+    return offset_;
+  }
+  uint32_t GetFontSize() const {
+    return font_size_;
+  }
+  Property GetFontFamily() const {
+    return font_family_;
+  }
+  Property GetFontWeight() const {
+    return font_weight_;
+  }
+  // Unescaped, as set.
+  std::string_view GetData() const {
+    return text_;
+  }
+
  private:
   Point coords_;
   Point offset_;
   uint32_t font_size_ = 1;
-  std::optional<std::string> font_family_;
-  std::optional<std::string> font_weight_;
-  std::string text_;
+  Property font_family_;
+  Property font_weight_;
+  std::pmr::string text_;
 };
 
 class Rectangle final : public Figure<Rectangle> {
  public:
+  friend class CompactDocument;
   Rectangle() = default;
 
+  Box Bounds() const;
   void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
 
   Rectangle &SetPoint(Point point);
   Rectangle &SetWidth(double width);
   Rectangle &SetHeight(double height);
 
+  Point GetPoint() const {
+    return point_;
+  }
+  double GetWidth() const {
+    return width_;
+  }
+  double GetHeight() const {
+    return height_;
+  }
+
  private:
   Point point_;
   double width_ = 0;
   double height_ = 0;
 };
 
+// Outline of straight segments: MoveTo starts a subpath, LineTo extends it
+// and Close joins it back to its start. The path data is written in its
+// shortest form, with relative or absolute coordinates, whichever is
+// shorter for each segment.
+class Path final : public Figure<Path> {
+ public:
+  friend class CompactDocument;
+  using allocator_type = Allocator;
+
+  enum class Command : uint8_t {
+    kMoveTo,
+    kLineTo,
+    kClose,
+  };
+
+  Path() = default;
+  explicit Path(const allocator_type &alloc);
+  Path(const Path &other) = default;
+  Path(Path &&other) = default;
+  Path(const Path &other, const allocator_type &alloc);
+  Path(Path &&other, const allocator_type &alloc);
+  Path &operator=(const Path &other) = default;
+  Path &operator=(Path &&other) = default;
+
+  Box Bounds() const;
+  void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
+
+  Path &MoveTo(Point point);
+  // Moves instead when the path is empty.
+  Path &LineTo(Point point);
+  // Does nothing when the path is empty.
+  Path &Close();
+  // Adds the points of the polyline as a new subpath.
+  Path &AddPolyline(const Polyline &polyline);
+  // Preallocates storage for count commands in total.
+  Path &Reserve(size_t count);
+
+  const std::pmr::vector<Command> &GetCommands() const {
+    return commands_;
+  }
+  // The points of the MoveTo and LineTo commands in order.
+  const std::pmr::vector<Point> &GetPoints() const {
+    return points_;
+  }
+
+ private:
+  std::pmr::vector<Command> commands_;
+  std::pmr::vector<Point> points_;
+};
+
 class Section final {
  public:
   friend class SectionBuilder;
+  friend class Snapshot;
+  Box Bounds() const;
   void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
+  // Sections are rendered already, so this only adds up their pieces; the
+  // group moving them to an origin is not counted.
+  uint64_t RenderedSize() const;
 
  private:
-  explicit Section(std::string rendered_data);
-
-  std::shared_ptr<std::string> rendered_data_;
+  // Rendered bytes as a list of immutable pieces. Sections added to a
+  // SectionBuilder share their large pieces with the new section instead of
+  // copying them.
+  struct Rope {
+    std::vector<std::shared_ptr<const std::string>> pieces;
+    std::vector<std::string_view> views;
+    Box bounds;
+  };
+
+  explicit Section(std::shared_ptr<const Rope> rope);
+
+  std::shared_ptr<const Rope> rope_;
 };
 
+// Objects wait in the builder's memory resource until Build, the built
+// section itself always uses the default heap so it may outlive it.
 class SectionBuilder final {
  public:
+  SectionBuilder() = default;
+  explicit SectionBuilder(std::pmr::memory_resource *resource);
+
   SectionBuilder &Add(const Object &object);
   SectionBuilder &Add(Object &&object);
-  Section Build();
+  // Objects rendered into the section are added to stats when given.
+  Section Build(RenderStats *stats = nullptr);
 
  private:
-  std::vector<Object> objects_;
+  std::pmr::vector<Object> objects_;
 };
 }
 
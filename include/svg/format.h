@@ -0,0 +1,32 @@
+#ifndef SVG_FORMAT_H_
+#define SVG_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace svg {
+// Size of a buffer that is always large enough for FormatNumber.
+constexpr size_t kMaxNumberLength = 64;
+// Largest precision of FormatRounded.
+constexpr int kMaxPrecision = 15;
+
+// Writes the shortest representation of value that reads back to the same
+// double. Returns the pointer past the last written character.
+char *FormatNumber(char *first, double value);
+// Number of characters FormatNumber writes, computed without writing them
+// for all but values too large, too small or too close to a tie to tell.
+size_t ShortestLength(double value);
+// Writes value with exactly precision digits after the decimal point.
+// Values too large for fixed notation fall back to the shortest form.
+char *FormatNumber(char *first, double value, int precision);
+char *FormatNumber(char *first, uint32_t value);
+// Writes value rounded to precision digits after the decimal point, at
+// most kMaxPrecision, without trailing zeros or the sign of zero. Works on
+// integers for values below 2^63 scaled, others fall back to the shortest
+// form of the rounded value.
+char *FormatRounded(char *first, double value, int precision);
+// Number of characters FormatRounded writes, computed without writing them.
+size_t RoundedLength(double value, int precision);
+}
+
+#endif // SVG_FORMAT_H_
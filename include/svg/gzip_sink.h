@@ -0,0 +1,46 @@
+#ifndef SVG_GZIP_SINK_H_
+#define SVG_GZIP_SINK_H_
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+#include "writer.h"
+
+struct z_stream_s;
+
+namespace svg {
+// Compresses everything written to it into the gzip format (.svgz) and
+// passes the compressed bytes to another sink as soon as its buffer fills,
+// so memory use does not depend on the document size. Finish writes the
+// gzip trailer, it is called by the destructor if needed; call it
+// explicitly, after flushing the writer, to observe errors. Throws
+// std::invalid_argument for levels outside 0-9 or an empty buffer,
+// std::logic_error for a Write after Finish and std::runtime_error when
+// compression fails.
+class GzipSink final : public Sink {
+ public:
+  static constexpr int kDefaultLevel = 6;
+  static constexpr size_t kDefaultBufferSize = 64 * 1024;
+
+  explicit GzipSink(Sink &out, int level = kDefaultLevel,
+                    size_t buffer_size = kDefaultBufferSize);
+  GzipSink(const GzipSink &) = delete;
+  GzipSink &operator=(const GzipSink &) = delete;
+  ~GzipSink() override;
+
+  void Write(std::string_view data) override;
+  void Finish();
+
+ private:
+  void Deflate(int flush);
+
+  Sink &out_;
+  std::unique_ptr<z_stream_s> stream_;
+  std::unique_ptr<unsigned char[]> buffer_;
+  size_t buffer_size_;
+  bool finished_ = false;
+};
+}
+
+#endif // SVG_GZIP_SINK_H_
@@ -0,0 +1,78 @@
+#ifndef SVG_PIPELINE_SINK_H_
+#define SVG_PIPELINE_SINK_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "writer.h"
+
+namespace svg {
+// Thrown by PipelineSink once it has been cancelled.
+class PipelineCancelled final : public std::runtime_error {
+ public:
+  PipelineCancelled() : std::runtime_error("svg::PipelineSink: cancelled") {}
+};
+
+// Copies everything written to it into chunks of chunk_size bytes and
+// passes them to another sink on a thread of its own, so formatting goes on
+// while that sink blocks on I/O. At most depth full chunks wait in the
+// queue and Write blocks while it is full, memory use stays within
+// depth + 2 chunks. An exception thrown by the other sink stops the thread,
+// drops the queue and is rethrown by the next Write and by Finish. Cancel,
+// from any thread, drops the queue and makes Write and Finish throw
+// PipelineCancelled; a write already passed to the other sink completes.
+// Finish sends the last partial chunk and waits for the queue to drain, it
+// is called by the destructor if needed; call it explicitly, after flushing
+// the writer, to observe errors. Write throws std::logic_error after Finish.
+class PipelineSink final : public Sink {
+ public:
+  static constexpr size_t kDefaultDepth = 4;
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+  explicit PipelineSink(Sink &out, size_t depth = kDefaultDepth,
+                        size_t chunk_size = kDefaultChunkSize);
+  PipelineSink(const PipelineSink &) = delete;
+  PipelineSink &operator=(const PipelineSink &) = delete;
+  ~PipelineSink() override;
+
+  void Write(std::string_view data) override;
+  void Finish();
+  void Cancel();
+
+ private:
+  // Queues the current chunk, waiting for room.
+  void Push();
+  // Throws the error or the cancellation that stopped the pipeline, if
+  // any. Called with the mutex held.
+  void ThrowIfStopped() const;
+  void Work();
+
+  Sink &out_;
+  size_t depth_;
+  size_t chunk_size_;
+  // Filled by Write, only touched by the formatting thread.
+  std::string current_;
+  bool finished_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable has_chunk_;
+  std::condition_variable has_room_;
+  std::deque<std::string> queue_;
+  // Written chunks kept for reuse.
+  std::vector<std::string> free_;
+  std::exception_ptr error_;
+  bool cancelled_ = false;
+  bool finishing_ = false;
+  std::thread thread_;
+};
+}
+
+#endif // SVG_PIPELINE_SINK_H_
@@ -0,0 +1,85 @@
+#ifndef SVG_PROPERTY_H_
+#define SVG_PROPERTY_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "common.h"
+#include "writer.h"
+
+namespace svg {
+// Handle to an attribute value interned in a process-wide pool. The pool
+// keeps the bytes written on render, escaped for XML once on interning.
+// Equal values share one entry, so handles are compared and hashed as
+// pointers. Entries are never evicted, the pool grows with every distinct
+// value until ClearPool or the process exits; SetPoolLimit caps it for
+// inputs with unbounded distinct values. A default constructed handle holds
+// no value.
+class Property final {
+ public:
+  // Entries of the pool and the bytes of their values.
+  struct PoolUsage {
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+
+  Property() = default;
+
+  static Property Intern(std::string_view value);
+  static Property Intern(const std::string &value) {
+    return Intern(std::string_view(value));
+  }
+  static Property Intern(const char *value) {
+    return Intern(std::string_view(value));
+  }
+  // Formats the color once, std::monostate gives an empty handle.
+  static Property Intern(const Color &color);
+
+  static PoolUsage Usage();
+  // Interning a new value that would take the pool over bytes throws
+  // std::length_error, values already interned are still found.
+  static void SetPoolLimit(size_t bytes);
+  // Frees every entry. Handles obtained before dangle, so it is only safe
+  // once no figure or style holding one is left.
+  static void ClearPool();
+
+  bool HasValue() const {
+    return value_ != nullptr;
+  }
+  std::string_view View() const {
+    return value_ != nullptr ? std::string_view(*value_) : std::string_view();
+  }
+
+  bool operator==(Property other) const {
+    return value_ == other.value_;
+  }
+  bool operator!=(Property other) const {
+    return value_ != other.value_;
+  }
+  size_t Hash() const {
+    return std::hash<const std::string *>{}(value_);
+  }
+
+ private:
+  explicit Property(const std::string *value) : value_(value) {}
+
+  const std::string *value_ = nullptr;
+};
+
+inline Writer &operator<<(Writer &out, Property property) {
+  return out << property.View();
+}
+
+// Writes a color handle, an empty one is written as "none".
+inline void RenderColor(Writer &out, Property color) {
+  if (color.HasValue()) {
+    out << color;
+  } else {
+    out << "none";
+  }
+}
+}
+
+#endif // SVG_PROPERTY_H_
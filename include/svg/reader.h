@@ -0,0 +1,27 @@
+#ifndef SVG_READER_H_
+#define SVG_READER_H_
+
+#include <string>
+#include <string_view>
+
+#include "document.h"
+#include "figures.h"
+
+namespace svg {
+// Rebuild objects from SVG in the subset this library writes: circle,
+// polyline, text, rect and straight-segment path elements with the
+// attributes of their setters, and the style sheet of documents rendered
+// with deduplicated styles. Sections are read back as the objects they
+// contain, moved by the translate() groups of renders with an origin. The
+// input is scanned in place, only the values kept by the objects are
+// copied. Throws std::runtime_error with the offset of the first
+// unsupported construct.
+Document ReadDocument(std::string_view svg);
+Section ReadSection(std::string_view svg);
+// Same for a file, which is mapped into memory. Also throws
+// std::system_error if it cannot be read.
+Document ReadDocumentFile(const std::string &path);
+Section ReadSectionFile(const std::string &path);
+}
+
+#endif // SVG_READER_H_
@@ -0,0 +1,45 @@
+#ifndef SVG_RENDER_OPTIONS_H_
+#define SVG_RENDER_OPTIONS_H_
+
+#include <cstddef>
+#include <optional>
+
+#include "common.h"
+#include "render_stats.h"
+#include "simplify.h"
+#include "thread_pool.h"
+
+namespace svg {
+// Document-wide settings applied while rendering.
+struct RenderOptions {
+  // Only objects whose bounds intersect the viewport are rendered.
+  std::optional<Box> viewport;
+  // Written as the viewBox of the svg element, in the coordinates written
+  // after subtracting the origin, and its size as the width and height of
+  // the drawing, which clips whatever lies outside.
+  std::optional<Box> view_box;
+  // Used for polylines that do not set their own simplification.
+  std::optional<Simplification> simplification;
+  // Emits every distinct figure style once as a CSS class and makes the
+  // figures refer to it instead of repeating their properties.
+  bool deduplicate_styles = false;
+  // Writes polylines as equivalent but shorter <path> elements.
+  bool polylines_as_paths = false;
+  // Rounds every coordinate and length to this many decimals, 0 for
+  // integers. Sections keep the numbers they were built with.
+  std::optional<int> precision;
+  // Subtracted from every position written, e.g. the corner of the
+  // viewport to write it as a drawing of its own. Sections are moved by a
+  // transform instead.
+  Point origin;
+  // Objects are formatted by this many threads into separate buffers that
+  // are written in order, so the output matches a serial render.
+  size_t threads = 1;
+  // Runs the formatting tasks instead of ThreadPool::Shared.
+  Executor *executor = nullptr;
+  // Collects per figure type totals of the render when set.
+  RenderStats *stats = nullptr;
+};
+}
+
+#endif // SVG_RENDER_OPTIONS_H_
@@ -0,0 +1,63 @@
+#ifndef SVG_RENDER_STATS_H_
+#define SVG_RENDER_STATS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+namespace svg {
+class Circle;
+class Polyline;
+class Text;
+class Rectangle;
+class Path;
+class Section;
+
+// Totals for the rendered objects of one figure type. Points are the
+// coordinate pairs written: polyline vertices after simplification, path
+// points and one per circle, text and rectangle. Sections have no points
+// of their own.
+struct FigureStats {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+  uint64_t points = 0;
+  std::chrono::nanoseconds time{0};
+
+  FigureStats &operator+=(const FigureStats &other);
+};
+
+// Filled by renders and section builds given a pointer to it, nothing is
+// measured otherwise. Totals are added to the values already there, so one
+// collector may gather several renders.
+struct RenderStats {
+  FigureStats circles;
+  FigureStats polylines;
+  FigureStats texts;
+  FigureStats rectangles;
+  FigureStats paths;
+  FigureStats sections;
+
+  template<typename FigureType>
+  FigureStats &Of() {
+    if constexpr (std::is_same_v<FigureType, Circle>) {
+      return circles;
+    } else if constexpr (std::is_same_v<FigureType, Polyline>) {
+      return polylines;
+    } else if constexpr (std::is_same_v<FigureType, Text>) {
+      return texts;
+    } else if constexpr (std::is_same_v<FigureType, Rectangle>) {
+      return rectangles;
+    } else if constexpr (std::is_same_v<FigureType, Path>) {
+      return paths;
+    } else {
+      static_assert(std::is_same_v<FigureType, Section>);
+      return sections;
+    }
+  }
+
+  FigureStats Total() const;
+  RenderStats &operator+=(const RenderStats &other);
+};
+}
+
+#endif // SVG_RENDER_STATS_H_
@@ -0,0 +1,88 @@
+#ifndef SVG_RETAINED_DOCUMENT_H_
+#define SVG_RETAINED_DOCUMENT_H_
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "common.h"
+#include "figures.h"
+#include "render_options.h"
+#include "simplify.h"
+#include "writer.h"
+
+namespace svg {
+// Document for scenes changing a little between renders. Every object keeps
+// its rendered markup, objects are changed through their ids, which marks
+// them dirty, and Render formats only the dirty objects and copies the
+// cached markup of the rest. Markup is formatted with the options of the
+// render, not the formatting state of the writer rendered to.
+class RetainedDocument final {
+ public:
+  // Stays valid for the lifetime of the document, also after Remove.
+  using Id = size_t;
+
+  Id Add(const Object &object);
+  Id Add(Object &&object);
+  const Object &Get(Id id) const;
+  // Marks the object dirty and calls modify with it. The object is only
+  // reachable during the call, so no reference to it outlives a render.
+  template<typename ModifyFn>
+  void Modify(Id id, ModifyFn &&modify) {
+    modify(ModifiedObject(id));
+  }
+  // Throws std::bad_variant_access if the object is no FigureType.
+  template<typename FigureType, typename ModifyFn>
+  void Modify(Id id, ModifyFn &&modify) {
+    modify(std::get<FigureType>(ModifiedObject(id)));
+  }
+  // Drops the object from the output, its id is not reused.
+  void Remove(Id id);
+
+  // Number of objects formatted by the next Render.
+  size_t DirtyCount() const;
+
+  void Render(std::ostream &out);
+  void Render(Writer &out);
+  // Objects are formatted with the simplification, polylines_as_paths,
+  // precision and origin of the options; a render changing any of them
+  // formats every object again. The viewport is applied to the cached
+  // bounds and stats count the objects formatted by this render. Throws
+  // std::invalid_argument for deduplicate_styles, threads above 1 or an
+  // executor, which cached markup cannot follow.
+  void Render(std::ostream &out, const RenderOptions &options);
+  void Render(Writer &out, const RenderOptions &options);
+
+ private:
+  struct Slot {
+    explicit Slot(Object added) : object(std::move(added)) {}
+
+    Object object;
+    std::string markup;
+    Box bounds;
+    bool dirty = true;
+    bool removed = false;
+  };
+
+  // Options the cached markup was formatted with.
+  struct Format {
+    std::optional<Simplification> simplification;
+    bool polylines_as_paths = false;
+    std::optional<int> precision;
+    Point origin;
+  };
+
+  void MarkDirty(Id id);
+  Object &ModifiedObject(Id id);
+
+  std::vector<Slot> slots_;
+  std::vector<Id> dirty_;
+  Format format_;
+};
+}
+
+#endif // SVG_RETAINED_DOCUMENT_H_
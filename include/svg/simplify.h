@@ -0,0 +1,32 @@
+#ifndef SVG_SIMPLIFY_H_
+#define SVG_SIMPLIFY_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "common.h"
+
+namespace svg {
+enum class SimplifyAlgorithm {
+  // Drops points closer than tolerance to the simplified line. The fast
+  // choice: simplifying is much cheaper than formatting the dropped points.
+  kDouglasPeucker,
+  // Repeatedly drops the point forming the smallest triangle with its
+  // neighbours while that triangle's area is below tolerance squared.
+  // Keeps more of the shape, but its heap costs more than formatting every
+  // point of a dense trace, so it shrinks the output, not the render time.
+  kVisvalingam,
+};
+
+struct Simplification {
+  SimplifyAlgorithm algorithm = SimplifyAlgorithm::kDouglasPeucker;
+  double tolerance = 0.0;
+};
+
+// Fills kept with the increasing indices of the points that survive
+// simplification. The first and the last points are always kept.
+void Simplify(const Point *points, size_t count,
+              const Simplification &simplification, std::vector<size_t> &kept);
+}
+
+#endif // SVG_SIMPLIFY_H_
@@ -0,0 +1,68 @@
+#ifndef SVG_SNAPSHOT_H_
+#define SVG_SNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "document.h"
+#include "figures.h"
+#include "render_options.h"
+#include "writer.h"
+
+namespace svg {
+class SpatialIndex;
+struct StyleIndex;
+
+// Writes the document in the snapshot format: a versioned header followed
+// by flat arrays of fixed-size records per figure type, points, styles and
+// strings, each aligned to 8 bytes, in the byte order of the host.
+void SaveSnapshot(const Document &doc, Sink &out);
+void SaveSnapshot(const Section &section, Sink &out);
+
+// Saved document read in place: the file is mapped into memory and Render
+// reads the records directly from the mapping. Only the styles and other
+// interned values are decoded on load. Copies share the mapping.
+class Snapshot final {
+ public:
+  static constexpr uint32_t kVersion = 2;
+
+  // Maps a snapshot file. Throws std::system_error if the file cannot be
+  // read and std::runtime_error if it is not a valid snapshot of this
+  // version.
+  static Snapshot Open(const std::string &path);
+  // Reads a copy of a snapshot held in memory, throws like Open.
+  static Snapshot FromBytes(std::string_view bytes);
+
+  size_t Size() const;
+  void Render(std::ostream &out) const;
+  void Render(Writer &out) const;
+  void Render(std::ostream &out, const RenderOptions &options) const;
+  void Render(Writer &out, const RenderOptions &options) const;
+  // Bytes Render writes with these options, exact and without keeping them.
+  uint64_t RenderedSize(const RenderOptions &options = {}) const;
+
+  // Rebuilds the saved objects.
+  Document ToDocument() const;
+  // Section of all the saved objects.
+  Section ToSection() const;
+
+ private:
+  struct Data;
+
+  explicit Snapshot(std::shared_ptr<const Data> data);
+
+  // Built on the first viewport render.
+  std::shared_ptr<const SpatialIndex> Index() const;
+
+  std::shared_ptr<const Data> data_;
+  mutable std::shared_ptr<const SpatialIndex> index_;
+  // Built on the first render with deduplicated styles.
+  mutable std::shared_ptr<const StyleIndex> style_index_;
+};
+}
+
+#endif // SVG_SNAPSHOT_H_
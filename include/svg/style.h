@@ -0,0 +1,59 @@
+#ifndef SVG_STYLE_H_
+#define SVG_STYLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "common.h"
+#include "property.h"
+#include "writer.h"
+
+namespace svg {
+// Presentation properties shared by all figures. Empty colors are written
+// as "none", empty linecap and linejoin are left out.
+struct Style {
+  Property fill_color;
+  Property stroke_color;
+  double stroke_width = 1.0;
+  Property linecap;
+  Property linejoin;
+};
+
+bool operator==(const Style &lhs, const Style &rhs);
+
+struct StyleHash {
+  size_t operator()(const Style &style) const;
+};
+
+// Grows a geometry box by half the stroke width on every side.
+Box AddStroke(Box box, const Style &style);
+
+// Writes the style as attributes each followed by a space: a class
+// reference when the writer has a style class set, presentation attributes
+// otherwise.
+void RenderStyle(Writer &out, const Style &style);
+
+// Distinct styles of a document, rendered once as a <style> element so that
+// elements refer to them by class.
+class StyleSheet final {
+ public:
+  // Returns the class number of the style, adding it if it is new, or
+  // nullopt for a style with values that cannot be written in CSS, such as
+  // a color holding ';' or '}', which stays in attributes.
+  std::optional<uint32_t> Add(const Style &style);
+  std::optional<uint32_t> Find(const Style &style) const;
+  const Style &Get(uint32_t id) const;
+  size_t Size() const;
+
+  void Render(Writer &out) const;
+
+ private:
+  std::unordered_map<Style, uint32_t, StyleHash> classes_;
+  std::vector<const Style *> styles_;
+};
+}
+
+#endif // SVG_STYLE_H_
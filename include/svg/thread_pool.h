@@ -0,0 +1,51 @@
+#ifndef SVG_THREAD_POOL_H_
+#define SVG_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace svg {
+// Runs tasks submitted by the library, implement it to plug in an external
+// thread pool. Tasks never throw.
+class Executor {
+ public:
+  virtual ~Executor() = default;
+
+  virtual void Execute(std::function<void()> task) = 0;
+};
+
+// Fixed set of worker threads sharing one task queue. The destructor runs the
+// tasks still queued and joins the workers.
+class ThreadPool final : public Executor {
+ public:
+  explicit ThreadPool(size_t threads);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool() override;
+
+  void Execute(std::function<void()> task) override;
+  size_t Size() const;
+
+  // Process-wide pool with at least threads workers, created on first use
+  // and replaced by a larger one when more are asked for. Renders without
+  // an executor run on it, so tasks on it must not start such renders.
+  static std::shared_ptr<ThreadPool> Shared(size_t threads);
+
+ private:
+  void Work();
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+}
+
+#endif // SVG_THREAD_POOL_H_
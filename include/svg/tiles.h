@@ -0,0 +1,42 @@
+#ifndef SVG_TILES_H_
+#define SVG_TILES_H_
+
+#include <cstddef>
+#include <functional>
+
+#include "common.h"
+#include "document.h"
+#include "render_options.h"
+#include "writer.h"
+
+namespace svg {
+// Columns by rows tiles of equal size, the first one at origin and the
+// others towards larger x and y.
+struct TileGrid {
+  Point origin;
+  double tile_width = 256;
+  double tile_height = 256;
+  size_t columns = 1;
+  size_t rows = 1;
+
+  Box TileBounds(size_t column, size_t row) const;
+};
+
+// Returns the sink the tile at column and row is written to. Called from
+// the rendering threads, possibly at the same time.
+using TileSinkFn = std::function<Sink &(size_t column, size_t row)>;
+
+// Writes every tile of the grid as a document of its own, holding the
+// objects whose bounds touch the tile, found with the spatial index of the
+// document, at positions relative to the corner of the tile and clipped to
+// it by the size and viewBox of the drawing. Tiles are spread over
+// options.threads threads of options.executor or of ThreadPool::Shared,
+// every thread reusing one writer buffer; the viewport, origin and view box
+// of the options are set per tile. A failing tile does
+// not stop the others, the first error is rethrown once all are done.
+void RenderTiles(const Document &doc, const TileGrid &grid,
+                 const TileSinkFn &sink_of,
+                 const RenderOptions &options = {});
+}
+
+#endif // SVG_TILES_H_
@@ -0,0 +1,229 @@
+#ifndef SVG_WRITER_H_
+#define SVG_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "format.h"
+
+namespace svg {
+struct Point;
+
+// Destination of the bytes collected by a Writer.
+class Sink {
+ public:
+  virtual ~Sink() = default;
+
+  virtual void Write(std::string_view data) = 0;
+  // Writes the pieces in order, by default one Write call per piece.
+  virtual void WriteVectored(const std::string_view *pieces, size_t count);
+};
+
+// Appends everything to a string.
+class StringSink final : public Sink {
+ public:
+  explicit StringSink(std::string &out);
+
+  void Write(std::string_view data) override;
+
+ private:
+  std::string &out_;
+};
+
+// Writes to a file descriptor, throws std::system_error on failure.
+class FdSink final : public Sink {
+ public:
+  explicit FdSink(int fd);
+
+  void Write(std::string_view data) override;
+  // Uses writev, so the pieces are never copied.
+  void WriteVectored(const std::string_view *pieces, size_t count) override;
+
+ private:
+  int fd_;
+};
+
+// Passes every flushed block to a user callback.
+class CallbackSink final : public Sink {
+ public:
+  using Callback = std::function<void(std::string_view)>;
+
+  explicit CallbackSink(Callback callback);
+
+  void Write(std::string_view data) override;
+
+ private:
+  Callback callback_;
+};
+
+// Adapter for the std::ostream based API.
+class OstreamSink final : public Sink {
+ public:
+  explicit OstreamSink(std::ostream &out);
+
+  void Write(std::string_view data) override;
+
+ private:
+  std::ostream &out_;
+};
+
+// Drops everything.
+class NullSink final : public Sink {
+ public:
+  void Write(std::string_view data) override;
+  void WriteVectored(const std::string_view *pieces, size_t count) override;
+};
+
+// Collects output in a fixed buffer allocated once and hands it to the sink
+// whenever the buffer is full. The destructor flushes the rest; call Flush
+// explicitly to observe sink errors.
+class Writer final {
+ public:
+  static constexpr size_t kDefaultCapacity = 64 * 1024;
+  // Smaller pieces are copied by WriteVectored.
+  static constexpr size_t kMinVectoredSize = 4 * 1024;
+  // Enough for measuring, the buffer stays in cache.
+  static constexpr size_t kMeasureCapacity = 4 * 1024;
+
+  explicit Writer(Sink &sink, size_t capacity = kDefaultCapacity);
+  // A writer that only measures its output for BytesWritten: nothing
+  // reaches a sink, and numbers and large pieces are counted without
+  // copying or formatting them.
+  static Writer Measuring(size_t capacity = kMeasureCapacity);
+  // Uses the caller's buffer of at least kMaxNumberLength bytes, e.g. a
+  // small one on the stack for a one-off write.
+  Writer(Sink &sink, char *buffer, size_t capacity);
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+  ~Writer();
+
+  Writer &operator<<(std::string_view data) {
+    if (data.size() > static_cast<size_t>(end_ - pos_)) {
+      WriteSlow(data);
+    } else {
+      std::memcpy(pos_, data.data(), data.size());
+      pos_ += data.size();
+    }
+    return *this;
+  }
+  Writer &operator<<(const std::string &data) {
+    return *this << std::string_view(data);
+  }
+  Writer &operator<<(const char *data) {
+    return *this << std::string_view(data);
+  }
+  Writer &operator<<(char c) {
+    if (pos_ == end_) {
+      Drain();
+    }
+    *pos_++ = c;
+    return *this;
+  }
+  // Coordinates and lengths, rounded when the writer has a precision.
+  Writer &operator<<(double value) {
+    if (counting_) {
+      written_ += precision_ < 0 ? ShortestLength(value)
+                                 : RoundedLength(value, precision_);
+    } else if (precision_ < 0) {
+      Reserve(kMaxNumberLength);
+      pos_ = FormatNumber(pos_, value);
+    } else {
+      Reserve(kMaxNumberLength);
+      pos_ = FormatRounded(pos_, value, precision_);
+    }
+    return *this;
+  }
+  Writer &operator<<(uint32_t value) {
+    Reserve(kMaxNumberLength);
+    pos_ = FormatNumber(pos_, value);
+    return *this;
+  }
+
+  // Writes the concatenation of the pieces. Large pieces are not copied into
+  // the buffer: the buffered bytes and the pieces go to the sink in a single
+  // vectored write.
+  void WriteVectored(const std::string_view *pieces, size_t count);
+  void Flush();
+  // Bytes written through this writer so far, flushed or not.
+  uint64_t BytesWritten() const {
+    return written_ + static_cast<uint64_t>(pos_ - buffer_);
+  }
+
+  // The next figure refers to this class of the document's style sheet
+  // instead of writing its style properties. Set per object by renders with
+  // deduplicated styles.
+  void SetStyleClass(std::optional<uint32_t> style_class) {
+    style_class_ = style_class.has_value() ? *style_class : kNoStyleClass;
+  }
+  std::optional<uint32_t> GetStyleClass() const {
+    return style_class_ == kNoStyleClass ? std::nullopt
+                                         : std::optional<uint32_t>(style_class_);
+  }
+  // Polylines are written as <path> elements, whose relative coordinates
+  // take fewer bytes for dense points.
+  void SetPolylinesAsPaths(bool polylines_as_paths) {
+    polylines_as_paths_ = polylines_as_paths;
+  }
+  bool GetPolylinesAsPaths() const {
+    return polylines_as_paths_;
+  }
+  // Rounds numbers to precision digits after the decimal point, 0 for
+  // integers, instead of writing their shortest exact form. Throws
+  // std::invalid_argument unless it is within [0, kMaxPrecision].
+  void SetPrecision(std::optional<int> precision);
+  std::optional<int> GetPrecision() const {
+    return precision_ < 0 ? std::nullopt : std::optional<int>(precision_);
+  }
+  // Figures write their positions relative to origin, so a region of a
+  // drawing can be written as a drawing of its own.
+  void SetOrigin(const Point &origin);
+  Point GetOrigin() const;
+  // Copies the formatting settings, such as the precision, from other.
+  void CopyFormat(const Writer &other) {
+    style_class_ = other.style_class_;
+    polylines_as_paths_ = other.polylines_as_paths_;
+    precision_ = other.precision_;
+    origin_x_ = other.origin_x_;
+    origin_y_ = other.origin_y_;
+  }
+
+ private:
+  Writer(Sink &sink, size_t capacity, bool counting);
+
+  void Reserve(size_t size) {
+    if (size > static_cast<size_t>(end_ - pos_)) {
+      Drain();
+    }
+  }
+  void Drain();
+  void WriteSlow(std::string_view data);
+
+  Sink &sink_;
+  // Null when the caller provides the buffer.
+  std::unique_ptr<char[]> owned_buffer_;
+  char *buffer_;
+  char *pos_;
+  char *end_;
+  // Bytes handed to the sink or only counted.
+  uint64_t written_ = 0;
+  bool counting_ = false;
+  static constexpr uint32_t kNoStyleClass = UINT32_MAX;
+
+  uint32_t style_class_ = kNoStyleClass;
+  bool polylines_as_paths_ = false;
+  // Negative for the shortest exact form.
+  int precision_ = -1;
+  // Point is not complete here, common.h includes this header.
+  double origin_x_ = 0;
+  double origin_y_ = 0;
+};
+}
+
+#endif // SVG_WRITER_H_
@@ -0,0 +1,209 @@
+#include "svg/batch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "forwarding_sink.h"
+#include "svg/document.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/thread_pool.h"
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+class Batch final {
+ public:
+  Batch(const BatchItem *items, const RenderOptions &options,
+        const BatchCallback &on_done)
+      : items_(items), options_(options), on_done_(on_done),
+        results_(options.stats) {}
+
+  // Renders the documents one after another, each with a single thread.
+  void RenderPack(const std::vector<size_t> &pack) {
+    Recover([&] {
+      auto buffer = AcquireBuffer();
+      RenderOptions options = options_;
+      options.threads = 1;
+      options.executor = nullptr;
+      for (size_t i : pack) {
+        Render(*buffer, i, options);
+      }
+      ReleaseBuffer(std::move(buffer));
+    });
+  }
+
+  // Renders one document with its chunks spread over the executor.
+  void RenderSplit(size_t i, Executor *executor, size_t threads) {
+    Recover([&] {
+      auto buffer = AcquireBuffer();
+      RenderOptions options = options_;
+      options.threads = threads;
+      options.executor = executor;
+      Render(*buffer, i, options);
+      ReleaseBuffer(std::move(buffer));
+    });
+  }
+
+  void TaskStarted() {
+    std::lock_guard lock(mutex_);
+    ++pending_tasks_;
+  }
+  void TaskDone() {
+    std::lock_guard lock(mutex_);
+    if (--pending_tasks_ == 0) {
+      tasks_done_.notify_all();
+    }
+  }
+  void WaitForTasks() {
+    std::unique_lock lock(mutex_);
+    tasks_done_.wait(lock, [this] {
+      return pending_tasks_ == 0;
+    });
+  }
+
+  std::exception_ptr FirstError() const {
+    return results_.FirstError();
+  }
+
+ private:
+  // Keeps an error outside of the documents, e.g. from allocating a buffer,
+  // for RenderBatch to rethrow once every task is done instead of letting
+  // it skip the end of a task.
+  template<typename RenderFn>
+  void Recover(const RenderFn &render) {
+    try {
+      render();
+    } catch (...) {
+      std::lock_guard lock(mutex_);
+      results_.Add(RenderStats{}, std::current_exception());
+    }
+  }
+
+  void Render(ForwardingWriter &buffer, size_t i, RenderOptions options) {
+    assert(items_[i].document != nullptr && items_[i].sink != nullptr);
+    RenderStats stats;
+    if (options.stats != nullptr) {
+      options.stats = &stats;
+    }
+    auto error = buffer.Render(*items_[i].document, options,
+                               [this, i]() -> Sink & {
+                                 return *items_[i].sink;
+                               });
+
+    std::lock_guard lock(mutex_);
+    if (on_done_) {
+      results_.Add(stats, nullptr);
+      try {
+        on_done_(i, error);
+      } catch (...) {
+        results_.Add(RenderStats{}, std::current_exception());
+      }
+    } else {
+      results_.Add(stats, error);
+    }
+  }
+
+  std::unique_ptr<ForwardingWriter> AcquireBuffer() {
+    {
+      std::lock_guard lock(mutex_);
+      if (!buffers_.empty()) {
+        auto buffer = std::move(buffers_.back());
+        buffers_.pop_back();
+        return buffer;
+      }
+    }
+    return std::make_unique<ForwardingWriter>();
+  }
+  void ReleaseBuffer(std::unique_ptr<ForwardingWriter> buffer) {
+    std::lock_guard lock(mutex_);
+    buffers_.push_back(std::move(buffer));
+  }
+
+  const BatchItem *items_;
+  const RenderOptions &options_;
+  const BatchCallback &on_done_;
+
+  std::mutex mutex_;
+  std::condition_variable tasks_done_;
+  size_t pending_tasks_ = 0;
+  // No more buffers are made than threads run at a time.
+  std::vector<std::unique_ptr<ForwardingWriter>> buffers_;
+  RenderResults results_;
+};
+}
+
+void RenderBatch(const BatchItem *items, size_t count,
+                 const RenderOptions &options, const BatchCallback &on_done) {
+  Batch batch(items, options, on_done);
+  std::vector<size_t> split;
+  std::vector<std::vector<size_t>> packs;
+  size_t pack_objects = 0;
+  for (size_t i = 0; i < count; ++i) {
+    size_t objects = items[i].document->Size();
+    if (objects >= kBatchTaskObjects) {
+      split.push_back(i);
+      continue;
+    }
+    if (packs.empty() || pack_objects >= kBatchTaskObjects) {
+      packs.emplace_back();
+      pack_objects = 0;
+    }
+    packs.back().push_back(i);
+    // Empty documents still cost their prologue.
+    pack_objects += objects + 1;
+  }
+
+  if (options.threads <= 1 && options.executor == nullptr) {
+    for (auto &pack : packs) {
+      batch.RenderPack(pack);
+    }
+    for (size_t i : split) {
+      batch.RenderSplit(i, nullptr, 1);
+    }
+  } else {
+    std::shared_ptr<ThreadPool> shared_pool;
+    Executor *executor = options.executor;
+    if (executor == nullptr) {
+      shared_pool = ThreadPool::Shared(options.threads);
+      executor = shared_pool.get();
+    }
+    size_t threads = std::max<size_t>(options.threads, 1);
+
+    for (auto &pack : packs) {
+      batch.TaskStarted();
+      auto task = [&batch, pack = std::move(pack)] {
+        batch.RenderPack(pack);
+        batch.TaskDone();
+      };
+      try {
+        executor->Execute(task);
+      } catch (...) {
+        task();
+      }
+    }
+    // Large documents are coordinated from this thread, which only waits,
+    // while their chunks queue up behind the packs on the executor.
+    for (size_t i : split) {
+      batch.RenderSplit(i, executor, threads);
+    }
+    batch.WaitForTasks();
+  }
+
+  if (auto error = batch.FirstError()) {
+    std::rethrow_exception(error);
+  }
+}
+
+void RenderBatch(const std::vector<BatchItem> &items,
+                 const RenderOptions &options, const BatchCallback &on_done) {
+  RenderBatch(items.data(), items.size(), options, on_done);
+}
+}
@@ -1,23 +1,35 @@
 #include "svg/common.h"
 
+#include <cstdint>
 #include <ostream>
 #include <variant>
 
+#include "svg/escape.h"
+#include "svg/writer.h"
+
 namespace svg {
 std::ostream &operator<<(std::ostream &out, const Color &col) {
+  OstreamSink sink(out);
+  char buffer[kMaxNumberLength * 2];
+  Writer writer(sink, buffer, sizeof(buffer));
+  writer << col;
+  writer.Flush();
+  return out;
+}
+
+Writer &operator<<(Writer &out, const Color &col) {
   if (std::holds_alternative<std::monostate>(col)) {
     out << "none";
   } else if (std::holds_alternative<std::string>(col)) {
-    out << std::get<std::string>(col);
+    WriteEscaped(out, std::get<std::string>(col));
   } else if (std::holds_alternative<Rgb>(col)) {
     auto rgb = std::get<Rgb>(col);
-    out << "rgb(" << static_cast<int>(rgb.red) << ',' <<
-        static_cast<int>(rgb.green) << ',' << static_cast<int>(rgb.blue) << ')';
+    out << "rgb(" << uint32_t{rgb.red} << ',' << uint32_t{rgb.green} << ',' <<
+        uint32_t{rgb.blue} << ')';
   } else {
     auto rgba = std::get<Rgba>(col);
-    out << "rgba(" << static_cast<int>(rgba.red) << ',' <<
-        static_cast<int>(rgba.green) << ',' << static_cast<int>(rgba.blue) <<
-        ',' << rgba.alpha << ')';
+    out << "rgba(" << uint32_t{rgba.red} << ',' << uint32_t{rgba.green} <<
+        ',' << uint32_t{rgba.blue} << ',' << rgba.alpha << ')';
   }
   return out;
 }
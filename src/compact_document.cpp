@@ -0,0 +1,263 @@
+#include "svg/compact_document.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "document_render.h"
+#include "figure_render.h"
+#include "spatial_index.h"
+#include "svg/common.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/style.h"
+#include "svg/writer.h"
+
+namespace svg {
+void CompactDocument::Add(const Circle &circle) {
+  AddEntry(kCircle, circle_centers_.size());
+  circle_centers_.push_back(circle.center_);
+  circle_radii_.push_back(circle.radius_);
+  circle_styles_.push_back(AddStyle(circle.GetStyle()));
+}
+
+void CompactDocument::Add(const Polyline &polyline) {
+  AddEntry(kPolyline, polyline_ends_.size());
+  if (polyline.simplification_.has_value()) {
+    simplifications_.emplace_back(polyline_ends_.size(),
+                                  *polyline.simplification_);
+  }
+  points_.insert(points_.end(), polyline.points_.begin(),
+                 polyline.points_.end());
+  polyline_ends_.push_back(points_.size());
+  polyline_styles_.push_back(AddStyle(polyline.GetStyle()));
+}
+
+void CompactDocument::Add(const Text &text) {
+  AddEntry(kText, texts_.size());
+  texts_.push_back(text);
+}
+
+void CompactDocument::Add(const Rectangle &rectangle) {
+  AddEntry(kRectangle, rectangle_points_.size());
+  rectangle_points_.push_back(rectangle.point_);
+  rectangle_widths_.push_back(rectangle.width_);
+  rectangle_heights_.push_back(rectangle.height_);
+  rectangle_styles_.push_back(AddStyle(rectangle.GetStyle()));
+}
+
+void CompactDocument::Add(const Path &path) {
+  AddEntry(kPath, path_command_ends_.size());
+  path_commands_.insert(path_commands_.end(), path.commands_.begin(),
+                        path.commands_.end());
+  path_points_.insert(path_points_.end(), path.points_.begin(),
+                      path.points_.end());
+  path_command_ends_.push_back(path_commands_.size());
+  path_point_ends_.push_back(path_points_.size());
+  path_styles_.push_back(AddStyle(path.GetStyle()));
+}
+
+void CompactDocument::Add(const Section &section) {
+  AddEntry(kSection, sections_.size());
+  sections_.push_back(section);
+}
+
+void CompactDocument::Add(const Object &object) {
+  std::visit([this](auto &&obj) {
+    Add(obj);
+  }, object);
+}
+
+size_t CompactDocument::Size() const {
+  return order_.size();
+}
+
+void CompactDocument::Render(std::ostream &out) const {
+  Render(out, RenderOptions{});
+}
+
+void CompactDocument::Render(Writer &out) const {
+  Render(out, RenderOptions{});
+}
+
+void CompactDocument::Render(std::ostream &out,
+                             const RenderOptions &options) const {
+  OstreamSink sink(out);
+  Writer writer(sink);
+  Render(writer, options);
+  writer.Flush();
+}
+
+void CompactDocument::Render(Writer &out,
+                             const RenderOptions &options) const {
+  RenderDocument(
+      out, options, order_.size(),
+      [this] {
+        return Index();
+      },
+      style_index_,
+      [this, &options](Writer &writer, size_t i, RenderStats *stats) {
+        RenderEntry(writer, i, options, stats);
+      },
+      [this](size_t i) {
+        return StyleOf(i);
+      });
+}
+
+uint64_t CompactDocument::RenderedSize(const RenderOptions &options) const {
+  return MeasureDocument(*this, options);
+}
+
+void CompactDocument::AddEntry(Kind kind, size_t position) {
+  if (position > kPositionMask) {
+    throw std::length_error("svg::CompactDocument: too many objects");
+  }
+  order_.push_back(kind << kKindShift | static_cast<uint32_t>(position));
+  index_.reset();
+  style_index_.reset();
+}
+
+uint32_t CompactDocument::AddStyle(const Style &style) {
+  auto [it, inserted] =
+      style_ids_.emplace(style, static_cast<uint32_t>(styles_.size()));
+  if (inserted) {
+    styles_.push_back(style);
+  }
+  return it->second;
+}
+
+const Style *CompactDocument::StyleOf(size_t i) const {
+  uint32_t position = order_[i] & kPositionMask;
+  switch (order_[i] >> kKindShift) {
+    case kCircle:
+      return &styles_[circle_styles_[position]];
+    case kPolyline:
+      return &styles_[polyline_styles_[position]];
+    case kText:
+      return &texts_[position].GetStyle();
+    case kRectangle:
+      return &styles_[rectangle_styles_[position]];
+    case kPath:
+      return &styles_[path_styles_[position]];
+    default:
+      return nullptr;
+  }
+}
+
+Box CompactDocument::BoundsOf(size_t i) const {
+  uint32_t position = order_[i] & kPositionMask;
+  switch (order_[i] >> kKindShift) {
+    case kCircle:
+      return CircleBounds(styles_[circle_styles_[position]],
+                          circle_centers_[position], circle_radii_[position]);
+    case kPolyline: {
+      size_t begin = position == 0 ? 0 : polyline_ends_[position - 1];
+      return PolylineBounds(styles_[polyline_styles_[position]],
+                            points_.data() + begin,
+                            polyline_ends_[position] - begin);
+    }
+    case kText:
+      return texts_[position].Bounds();
+    case kRectangle:
+      return RectangleBounds(styles_[rectangle_styles_[position]],
+                             rectangle_points_[position],
+                             rectangle_widths_[position],
+                             rectangle_heights_[position]);
+    case kPath: {
+      size_t begin = position == 0 ? 0 : path_point_ends_[position - 1];
+      return PolylineBounds(styles_[path_styles_[position]],
+                            path_points_.data() + begin,
+                            path_point_ends_[position] - begin);
+    }
+    default:
+      return sections_[position].Bounds();
+  }
+}
+
+void CompactDocument::RenderEntry(Writer &out, size_t i,
+                                  const RenderOptions &options,
+                                  RenderStats *stats) const {
+  uint32_t position = order_[i] & kPositionMask;
+  switch (order_[i] >> kKindShift) {
+    case kCircle:
+      RenderRecorded<Circle>(out, stats, [&] {
+        RenderCircle(out, styles_[circle_styles_[position]],
+                     circle_centers_[position], circle_radii_[position]);
+        return 1;
+      });
+      break;
+    case kPolyline:
+      RenderRecorded<Polyline>(out, stats, [&] {
+        const std::optional<Simplification> *simplification =
+            &options.simplification;
+        std::optional<Simplification> own;
+        if (!simplifications_.empty()) {
+          auto it = std::lower_bound(
+              simplifications_.begin(), simplifications_.end(), position,
+              [](const auto &entry, uint32_t value) {
+                return entry.first < value;
+              });
+          if (it != simplifications_.end() && it->first == position) {
+            own = it->second;
+            simplification = &own;
+          }
+        }
+        size_t begin = position == 0 ? 0 : polyline_ends_[position - 1];
+        return RenderPolyline(out, styles_[polyline_styles_[position]],
+                              points_.data() + begin,
+                              polyline_ends_[position] - begin,
+                              *simplification);
+      });
+      break;
+    case kText:
+      RenderRecorded<Text>(out, stats, [&] {
+        return RenderObject(out, texts_[position], std::nullopt);
+      });
+      break;
+    case kRectangle:
+      RenderRecorded<Rectangle>(out, stats, [&] {
+        RenderRectangle(out, styles_[rectangle_styles_[position]],
+                        rectangle_points_[position],
+                        rectangle_widths_[position],
+                        rectangle_heights_[position]);
+        return 1;
+      });
+      break;
+    case kPath:
+      RenderRecorded<Path>(out, stats, [&] {
+        size_t begin = position == 0 ? 0 : path_command_ends_[position - 1];
+        size_t points_begin =
+            position == 0 ? 0 : path_point_ends_[position - 1];
+        return RenderPath(out, styles_[path_styles_[position]],
+                          path_commands_.data() + begin,
+                          path_command_ends_[position] - begin,
+                          path_points_.data() + points_begin);
+      });
+      break;
+    default:
+      RenderRecorded<Section>(out, stats, [&] {
+        return RenderObject(out, sections_[position], std::nullopt);
+      });
+      break;
+  }
+}
+
+std::shared_ptr<const SpatialIndex> CompactDocument::Index() const {
+  return LazyIndex(index_, [this] {
+    std::vector<Box> boxes;
+    boxes.reserve(order_.size());
+    for (size_t i = 0; i < order_.size(); ++i) {
+      boxes.push_back(BoundsOf(i));
+    }
+    return SpatialIndex(boxes);
+  });
+}
+}
@@ -1,29 +1,137 @@
 #include "svg/document.h"
 
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
+#include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
+#include "document_render.h"
+#include "figure_render.h"
+#include "object_storage.h"
+#include "spatial_index.h"
+#include "svg/common.h"
 #include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/style.h"
+#include "svg/writer.h"
 
 namespace svg {
+namespace {
+void RenderObject(Writer &out, const Object &object,
+                  const RenderOptions &options, RenderStats *stats) {
+  std::visit([&out, &options, stats](auto &&obj) {
+    using ObjectType = std::decay_t<decltype(obj)>;
+    RenderRecorded<ObjectType>(out, stats, [&] {
+      return RenderObject(out, obj, options.simplification);
+    });
+  }, object);
+}
+}
+
+Document::Document(std::pmr::memory_resource *resource)
+    : objects_(resource) {}
+
 void Document::Add(const Object &object) {
-  objects_.push_back(object);
+  EmplaceObject(objects_, object);
+  index_.reset();
+  style_index_.reset();
 }
 void Document::Add(Object &&object) {
-  objects_.push_back(std::move(object));
+  EmplaceObject(objects_, std::move(object));
+  index_.reset();
+  style_index_.reset();
+}
+
+size_t Document::Size() const {
+  return objects_.size();
+}
+
+const Object &Document::Get(size_t i) const {
+  return objects_[i];
 }
 
 void Document::Render(std::ostream &out) const {
-  out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"
-         "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">";
+  Render(out, RenderOptions{});
+}
 
-  for (auto &object : objects_) {
-    std::visit([&out](auto &&obj) {
-      obj.Render(out);
-    }, object);
-  }
+void Document::Render(Writer &out) const {
+  Render(out, RenderOptions{});
+}
+
+void Document::Render(std::ostream &out, const RenderOptions &options) const {
+  OstreamSink sink(out);
+  Writer writer(sink);
+  Render(writer, options);
+  writer.Flush();
+}
+
+void Document::Render(Writer &out, const RenderOptions &options) const {
+  RenderDocument(
+      out, options, objects_.size(),
+      [this] {
+        return Index();
+      },
+      style_index_,
+      [this, &options](Writer &writer, size_t i, RenderStats *stats) {
+        RenderObject(writer, objects_[i], options, stats);
+      },
+      [this](size_t i) {
+        return std::visit([](auto &&obj) -> const Style * {
+          using ObjectType = std::decay_t<decltype(obj)>;
+          if constexpr (std::is_same_v<ObjectType, Section>) {
+            return nullptr;
+          } else {
+            return &obj.GetStyle();
+          }
+        }, objects_[i]);
+      });
+}
+
+uint64_t Document::RenderedSize(const RenderOptions &options) const {
+  return MeasureDocument(*this, options);
+}
+
+void Document::BuildIndex() const {
+  Index();
+}
+
+std::shared_ptr<const SpatialIndex> Document::Index() const {
+  return LazyIndex(index_, [this] {
+    std::vector<Box> boxes;
+    boxes.reserve(objects_.size());
+    for (auto &object : objects_) {
+      boxes.push_back(Bounds(object));
+    }
+    return SpatialIndex(boxes);
+  });
+}
 
-  out << "</svg>";
+StreamingDocument::StreamingDocument(Writer &out) : out_(out) {
+  out_ << kPrologue;
+}
+
+StreamingDocument::~StreamingDocument() {
+  try {
+    Finish();
+  } catch (...) {}
+}
+
+StreamingDocument &StreamingDocument::Add(const Object &object) {
+  std::visit([this](auto &&obj) {
+    Add(obj);
+  }, object);
+  return *this;
+}
+
+void StreamingDocument::Finish() {
+  if (!finished_) {
+    out_ << kEpilogue;
+    finished_ = true;
+  }
 }
 }
@@ -0,0 +1,301 @@
+#ifndef SVG_DOCUMENT_RENDER_H_
+#define SVG_DOCUMENT_RENDER_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "spatial_index.h"
+#include "svg/common.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/style.h"
+#include "svg/thread_pool.h"
+#include "svg/writer.h"
+
+namespace svg {
+inline constexpr char kPrologue[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">";
+inline constexpr char kEpilogue[] = "</svg>";
+
+// Writes the prologue, with the size and viewBox of the drawing if given.
+inline void WritePrologue(Writer &out, const std::optional<Box> &view_box) {
+  if (!view_box.has_value()) {
+    out << kPrologue;
+    return;
+  }
+  if (view_box->Empty()) {
+    throw std::invalid_argument("svg::RenderOptions: empty view box");
+  }
+  double width = view_box->max.x - view_box->min.x;
+  double height = view_box->max.y - view_box->min.y;
+  // The prologue without the > closing the svg element.
+  out << std::string_view(kPrologue, sizeof(kPrologue) - 2);
+  out << " width=\"" << width << "\" height=\"" << height << "\" viewBox=\""
+      << view_box->min.x << ' ' << view_box->min.y << ' ' << width << ' '
+      << height << "\">";
+}
+
+// Parallel renders give every thread several chunks to balance uneven
+// objects, but never chunks so small that the overhead dominates.
+inline constexpr size_t kChunksPerThread = 4;
+inline constexpr size_t kMinObjectsPerChunk = 256;
+inline constexpr size_t kChunkWriterCapacity = 16 * 1024;
+
+// Restores the formatting settings of a writer on scope exit.
+class FormatScope final {
+ public:
+  explicit FormatScope(Writer &out)
+      : out_(out),
+        style_class_(out.GetStyleClass()),
+        polylines_as_paths_(out.GetPolylinesAsPaths()),
+        precision_(out.GetPrecision()),
+        origin_(out.GetOrigin()) {}
+  ~FormatScope() {
+    out_.SetStyleClass(style_class_);
+    out_.SetPolylinesAsPaths(polylines_as_paths_);
+    out_.SetPrecision(precision_);
+    out_.SetOrigin(origin_);
+  }
+
+ private:
+  Writer &out_;
+  std::optional<uint32_t> style_class_;
+  bool polylines_as_paths_;
+  std::optional<int> precision_;
+  Point origin_;
+};
+
+// Style sheet classes of the objects of a document, built by its first
+// render with deduplicated styles and kept until it changes, so later
+// renders do not hash every style again.
+struct StyleIndex {
+  static constexpr uint32_t kNoClass = UINT32_MAX;
+
+  StyleSheet sheet;
+  // Class of every object in draw order, kNoClass for objects without a
+  // style or with one that stays in attributes.
+  std::vector<uint32_t> classes;
+};
+
+// Formats count objects split into chunks on separate threads and writes
+// the chunks to out in order as soon as each one is ready.
+template<typename RenderRange>
+void RenderInParallel(Writer &out, size_t count,
+                      const RenderRange &render_range,
+                      const RenderOptions &options) {
+  struct Chunk {
+    std::string data;
+    std::exception_ptr error;
+    bool done = false;
+  };
+
+  size_t chunk_count = std::min(
+      options.threads * kChunksPerThread,
+      (count + kMinObjectsPerChunk - 1) / kMinObjectsPerChunk);
+  std::vector<Chunk> chunks(chunk_count);
+  std::mutex mutex;
+  std::condition_variable chunk_done;
+
+  std::shared_ptr<ThreadPool> shared_pool;
+  Executor *executor = options.executor;
+  if (executor == nullptr) {
+    shared_pool = ThreadPool::Shared(options.threads);
+    executor = shared_pool.get();
+  }
+
+  for (size_t i = 0; i < chunk_count; ++i) {
+    size_t first = count * i / chunk_count;
+    size_t last = count * (i + 1) / chunk_count;
+    auto task = [&, i, first, last] {
+      auto &chunk = chunks[i];
+      try {
+        StringSink sink(chunk.data);
+        Writer writer(sink, kChunkWriterCapacity);
+        writer.CopyFormat(out);
+        render_range(writer, first, last);
+        writer.Flush();
+      } catch (...) {
+        chunk.error = std::current_exception();
+      }
+      std::lock_guard lock(mutex);
+      chunk.done = true;
+      chunk_done.notify_all();
+    };
+    try {
+      executor->Execute(std::move(task));
+    } catch (...) {
+      std::lock_guard lock(mutex);
+      for (size_t j = i; j < chunk_count; ++j) {
+        chunks[j].error = std::current_exception();
+        chunks[j].done = true;
+      }
+      break;
+    }
+  }
+
+  // Every chunk is waited for even after a failure, the tasks refer to
+  // this frame.
+  std::exception_ptr error;
+  for (auto &chunk : chunks) {
+    {
+      std::unique_lock lock(mutex);
+      chunk_done.wait(lock, [&chunk] {
+        return chunk.done;
+      });
+    }
+    if (!error) {
+      error = chunk.error;
+    }
+    if (!error) {
+      try {
+        out << chunk.data;
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    std::string().swap(chunk.data);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Renders a document of count objects numbered in draw order:
+// render_object(writer, i, stats) writes object i, adding it to stats unless
+// they are null, and style_of(i) returns its style, or nullptr if it has
+// none. index() returns the spatial index of the objects and is called for
+// viewport renders only; style_index caches the classes of the objects for
+// renders with deduplicated styles.
+template<typename IndexFn, typename RenderObjectFn, typename StyleOfFn>
+void RenderDocument(Writer &out, const RenderOptions &options, size_t count,
+                    const IndexFn &index,
+                    std::shared_ptr<const StyleIndex> &style_index,
+                    const RenderObjectFn &render_object,
+                    const StyleOfFn &style_of) {
+  std::vector<size_t> visible;
+  if (options.viewport.has_value()) {
+    index()->Query(*options.viewport, visible);
+  }
+  bool all = !options.viewport.has_value();
+  size_t total = count;
+  if (!all) {
+    count = visible.size();
+  }
+  // Style sheet classes of the objects in draw order.
+  const uint32_t *style_classes = nullptr;
+  auto render_at = [&](Writer &writer, size_t i, RenderStats *stats) {
+    if (style_classes != nullptr) {
+      uint32_t id = style_classes[i];
+      writer.SetStyleClass(id == StyleIndex::kNoClass
+                               ? std::nullopt
+                               : std::optional<uint32_t>(id));
+    }
+    render_object(writer, all ? i : visible[i], stats);
+  };
+  // Every range collects its own stats, parallel ranges merge them.
+  std::mutex stats_mutex;
+  auto render_range = [&](Writer &writer, size_t first, size_t last) {
+    if (options.stats == nullptr) {
+      for (size_t i = first; i < last; ++i) {
+        render_at(writer, i, nullptr);
+      }
+      return;
+    }
+    RenderStats stats;
+    for (size_t i = first; i < last; ++i) {
+      render_at(writer, i, &stats);
+    }
+    std::lock_guard lock(stats_mutex);
+    *options.stats += stats;
+  };
+
+  WritePrologue(out, options.view_box);
+
+  FormatScope format_scope(out);
+  if (options.polylines_as_paths) {
+    out.SetPolylinesAsPaths(true);
+  }
+  if (options.precision.has_value()) {
+    out.SetPrecision(options.precision);
+  }
+  if (options.origin.x != 0 || options.origin.y != 0) {
+    out.SetOrigin(options.origin);
+  }
+  std::shared_ptr<const StyleIndex> styles;
+  std::vector<uint32_t> visible_classes;
+  if (options.deduplicate_styles) {
+    styles = LazyIndex(style_index, [total, &style_of] {
+      StyleIndex built;
+      built.classes.resize(total, StyleIndex::kNoClass);
+      for (size_t i = 0; i < total; ++i) {
+        if (const Style *style = style_of(i)) {
+          if (auto id = built.sheet.Add(*style)) {
+            built.classes[i] = *id;
+          }
+        }
+      }
+      return built;
+    });
+    if (all) {
+      styles->sheet.Render(out);
+      style_classes = styles->classes.data();
+    } else {
+      // Only the classes of visible objects are written, numbered in the
+      // order they are first used.
+      StyleSheet visible_sheet;
+      std::vector<uint32_t> renumbered(styles->sheet.Size(),
+                                       StyleIndex::kNoClass);
+      visible_classes.resize(count, StyleIndex::kNoClass);
+      for (size_t i = 0; i < count; ++i) {
+        uint32_t id = styles->classes[visible[i]];
+        if (id == StyleIndex::kNoClass) {
+          continue;
+        }
+        if (renumbered[id] == StyleIndex::kNoClass) {
+          renumbered[id] = *visible_sheet.Add(styles->sheet.Get(id));
+        }
+        visible_classes[i] = renumbered[id];
+      }
+      visible_sheet.Render(out);
+      style_classes = visible_classes.data();
+    }
+  }
+
+  if (options.threads > 1 && count > kMinObjectsPerChunk) {
+    RenderInParallel(out, count, render_range, options);
+  } else {
+    render_range(out, 0, count);
+  }
+
+  out << kEpilogue;
+}
+
+// Renders the document into a writer that counts the bytes instead of
+// keeping them, so the size follows every option the render does. Chunks
+// of a parallel render would be formatted into strings only to be counted,
+// so the measure runs on the calling thread.
+template<typename DocumentType>
+uint64_t MeasureDocument(const DocumentType &doc,
+                         const RenderOptions &options) {
+  RenderOptions serial = options;
+  serial.threads = 1;
+  serial.executor = nullptr;
+  auto out = Writer::Measuring();
+  doc.Render(out, serial);
+  return out.BytesWritten();
+}
+}
+
+#endif // SVG_DOCUMENT_RENDER_H_
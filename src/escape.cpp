@@ -0,0 +1,130 @@
+#include "svg/escape.h"
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+bool IsSpecial(char c) {
+  return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+}
+
+std::string_view Reference(char c) {
+  switch (c) {
+    case '&':
+      return "&amp;";
+    case '<':
+      return "&lt;";
+    case '>':
+      return "&gt;";
+    case '"':
+      return "&quot;";
+    default:
+      return "&apos;";
+  }
+}
+
+// Calls write for every clean run and character reference of data in
+// order.
+template<typename WriteFn>
+void ForEachEscapedPiece(std::string_view data, const WriteFn &write) {
+  while (!data.empty()) {
+    size_t pos = FindSpecialChar(data);
+    if (pos == data.size()) {
+      write(data);
+      return;
+    }
+    if (pos != 0) {
+      write(data.substr(0, pos));
+    }
+    write(Reference(data[pos]));
+    data.remove_prefix(pos + 1);
+  }
+}
+}
+
+size_t FindSpecialChar(std::string_view data) {
+  const char *begin = data.data();
+  size_t size = data.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i amp = _mm_set1_epi8('&');
+  const __m128i lt = _mm_set1_epi8('<');
+  const __m128i gt = _mm_set1_epi8('>');
+  const __m128i quot = _mm_set1_epi8('"');
+  const __m128i apos = _mm_set1_epi8('\'');
+  for (; i + 16 <= size; i += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin + i));
+    __m128i found = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, amp), _mm_cmpeq_epi8(chunk, lt)),
+        _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, gt),
+                         _mm_cmpeq_epi8(chunk, quot)),
+            _mm_cmpeq_epi8(chunk, apos)));
+    if (int mask = _mm_movemask_epi8(found)) {
+      return i + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    if (IsSpecial(begin[i])) {
+      return i;
+    }
+  }
+  return size;
+}
+
+void WriteEscaped(Writer &out, std::string_view data) {
+  ForEachEscapedPiece(data, [&out](std::string_view piece) {
+    out << piece;
+  });
+}
+
+std::string Unescape(std::string_view data) {
+  static constexpr std::string_view kReferences[] = {
+      "&amp;", "&lt;", "&gt;", "&quot;", "&apos;"};
+  static constexpr char kChars[] = {'&', '<', '>', '"', '\''};
+
+  std::string result;
+  result.reserve(data.size());
+  while (!data.empty()) {
+    size_t pos = data.find('&');
+    result.append(data.substr(0, pos));
+    if (pos == std::string_view::npos) {
+      break;
+    }
+    data.remove_prefix(pos);
+    size_t i = 0;
+    while (i < std::size(kReferences) &&
+        data.substr(0, kReferences[i].size()) != kReferences[i]) {
+      ++i;
+    }
+    if (i < std::size(kReferences)) {
+      result += kChars[i];
+      data.remove_prefix(kReferences[i].size());
+    } else {
+      result += '&';
+      data.remove_prefix(1);
+    }
+  }
+  return result;
+}
+
+std::string Escape(std::string_view data) {
+  std::string result;
+  result.reserve(data.size());
+  ForEachEscapedPiece(data, [&result](std::string_view piece) {
+    result.append(piece);
+  });
+  return result;
+}
+}
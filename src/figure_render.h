@@ -0,0 +1,87 @@
+#ifndef SVG_FIGURE_RENDER_H_
+#define SVG_FIGURE_RENDER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include "svg/common.h"
+#include "svg/figures.h"
+#include "svg/property.h"
+#include "svg/render_stats.h"
+#include "svg/simplify.h"
+#include "svg/style.h"
+#include "svg/writer.h"
+
+namespace svg {
+// Markup of the figures from their fields, shared by the figure classes and
+// storages keeping the fields in their own layout.
+void RenderCircle(Writer &out, const Style &style, Point center,
+                  double radius);
+// Returns the number of points written.
+size_t RenderPolyline(Writer &out, const Style &style, const Point *points,
+                    size_t count,
+                    const std::optional<Simplification> &simplification);
+void RenderText(Writer &out, const Style &style, Point point, Point offset,
+                uint32_t font_size, Property font_family,
+                Property font_weight, std::string_view data);
+void RenderRectangle(Writer &out, const Style &style, Point point,
+                     double width, double height);
+// Commands other than kClose take the next point. Returns the number of
+// points written.
+size_t RenderPath(Writer &out, const Style &style,
+                  const Path::Command *commands, size_t count,
+                  const Point *points);
+// Writes the stored markup of a section, in a group moving it to the origin
+// of the writer if it has one.
+void RenderSection(Writer &out, const std::string_view *pieces,
+                   size_t count);
+
+Box CircleBounds(const Style &style, Point center, double radius);
+Box PolylineBounds(const Style &style, const Point *points, size_t count);
+Box TextBounds(const Style &style, Point point, Point offset,
+               uint32_t font_size, size_t length);
+Box RectangleBounds(const Style &style, Point point, double width,
+                    double height);
+
+// Writes an object of a document, polylines fall back to simplification.
+// Returns the number of points written as counted by RenderStats.
+template<typename FigureType>
+size_t RenderObject(Writer &out, const FigureType &figure,
+                    const std::optional<Simplification> &simplification) {
+  if constexpr (std::is_same_v<FigureType, Polyline>) {
+    return figure.Render(out, simplification);
+  } else if constexpr (std::is_same_v<FigureType, Path>) {
+    figure.Render(out);
+    return figure.GetPoints().size();
+  } else {
+    figure.Render(out);
+    return std::is_same_v<FigureType, Section> ? 0 : 1;
+  }
+}
+
+// Calls render, which writes an object of FigureType to out and returns
+// the number of points written, and adds the object to stats unless they
+// are null.
+template<typename FigureType, typename RenderFn>
+void RenderRecorded(Writer &out, RenderStats *stats, const RenderFn &render) {
+  if (stats == nullptr) {
+    render();
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+  uint64_t bytes = out.BytesWritten();
+  size_t points = render();
+  auto &figure_stats = stats->Of<FigureType>();
+  ++figure_stats.count;
+  figure_stats.bytes += out.BytesWritten() - bytes;
+  figure_stats.points += points;
+  figure_stats.time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+}
+
+#endif // SVG_FIGURE_RENDER_H_
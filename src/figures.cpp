@@ -1,22 +1,224 @@
 #include "svg/figures.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <ostream>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
+#include "figure_render.h"
+#include "object_storage.h"
+#include "path_encoder.h"
 #include "svg/common.h"
+#include "svg/escape.h"
+#include "svg/property.h"
+#include "svg/simplify.h"
+#include "svg/style.h"
+#include "svg/writer.h"
 
 namespace svg {
-void Circle::Render(std::ostream &out) const {
+namespace {
+// Stream output of single figures is small, a stack buffer saves the heap
+// allocation of a writer's own.
+constexpr size_t kStreamBufferSize = 1024;
+
+template<typename Renderable>
+void RenderToStream(const Renderable &renderable, std::ostream &out) {
+  OstreamSink sink(out);
+  char buffer[kStreamBufferSize];
+  Writer writer(sink, buffer, sizeof(buffer));
+  renderable.Render(writer);
+  writer.Flush();
+}
+
+Point Relative(Point point, Point origin) {
+  return {point.x - origin.x, point.y - origin.y};
+}
+}
+
+void RenderCircle(Writer &out, const Style &style, Point center,
+                  double radius) {
+  center = Relative(center, out.GetOrigin());
   out << "<circle ";
-  RenderProperties(out);
-  out << "cx=\"" << center_.x << "\" " <<
-      "cy=\"" << center_.y << "\" " <<
-      "r=\"" << radius_ << "\"" << "/>";
+  RenderStyle(out, style);
+  out << "cx=\"" << center.x << "\" " <<
+      "cy=\"" << center.y << "\" " <<
+      "r=\"" << radius << "\"" << "/>";
+}
+
+size_t RenderPolyline(Writer &out, const Style &style, const Point *points,
+                      size_t count,
+                      const std::optional<Simplification> &simplification) {
+  const size_t *kept = nullptr;
+  if (simplification.has_value() && count > 2) {
+    thread_local std::vector<size_t> kept_points;
+    Simplify(points, count, *simplification, kept_points);
+    kept = kept_points.data();
+    count = kept_points.size();
+  }
+  Point origin = out.GetOrigin();
+
+  if (out.GetPolylinesAsPaths()) {
+    out << "<path ";
+    RenderStyle(out, style);
+    out << "d=\"";
+    PathEncoder encoder(out);
+    for (size_t i = 0; i < count; ++i) {
+      Point point = Relative(points[kept ? kept[i] : i], origin);
+      if (i == 0) {
+        encoder.MoveTo(point);
+      } else {
+        encoder.LineTo(point);
+      }
+    }
+  } else {
+    out << "<polyline ";
+    RenderStyle(out, style);
+    out << "points=\"";
+    for (size_t i = 0; i < count; ++i) {
+      if (i != 0) {
+        out << ' ';
+      }
+      Point point = Relative(points[kept ? kept[i] : i], origin);
+      out << point.x << ',' << point.y;
+    }
+  }
+
+  out << "\"/>";
+  return count;
+}
+
+size_t RenderPath(Writer &out, const Style &style,
+                  const Path::Command *commands, size_t count,
+                  const Point *points) {
+  out << "<path ";
+  RenderStyle(out, style);
+  out << "d=\"";
+  PathEncoder encoder(out);
+  Point origin = out.GetOrigin();
+  size_t point_count = 0;
+  for (size_t i = 0; i < count; ++i) {
+    switch (commands[i]) {
+      case Path::Command::kMoveTo:
+        encoder.MoveTo(Relative(points[point_count++], origin));
+        break;
+      case Path::Command::kLineTo:
+        encoder.LineTo(Relative(points[point_count++], origin));
+        break;
+      case Path::Command::kClose:
+        encoder.Close();
+        break;
+    }
+  }
+  out << "\"/>";
+  return point_count;
+}
+
+void RenderText(Writer &out, const Style &style, Point point, Point offset,
+                uint32_t font_size, Property font_family,
+                Property font_weight, std::string_view data) {
+  point = Relative(point, out.GetOrigin());
+  out << "<text ";
+  RenderStyle(out, style);
+  out << "x=\"" << point.x << "\" " <<
+      "y=\"" << point.y << "\" " <<
+      "dx=\"" << offset.x << "\" " <<
+      "dy=\"" << offset.y << "\" " <<
+      "font-size=\"" << font_size << "\"";
+  if (font_family.HasValue()) {
+    out << " font-family=\"" << font_family << "\"";
+  }
+  if (font_weight.HasValue()) {
+    out << " font-weight=\"" << font_weight << "\"";
+  }
+  out << '>';
+  WriteEscaped(out, data);
+  out << "</text>";
+}
+
+void RenderRectangle(Writer &out, const Style &style, Point point,
+                     double width, double height) {
+  point = Relative(point, out.GetOrigin());
+  out << "<rect ";
+  out << "x=\"" << point.x << "\" " <<
+      "y=\"" << point.y << "\" " <<
+      "width=\"" << width << "\" " <<
+      "height=\"" << height << "\" ";
+  RenderStyle(out, style);
+  out << "/>";
+}
+
+void RenderSection(Writer &out, const std::string_view *pieces,
+                   size_t count) {
+  Point origin = out.GetOrigin();
+  if (origin.x == 0 && origin.y == 0) {
+    out.WriteVectored(pieces, count);
+    return;
+  }
+  Point shift = Relative({0, 0}, origin);
+  out << "<g transform=\"translate(" << shift.x << ' ' << shift.y << ")\">";
+  out.WriteVectored(pieces, count);
+  out << "</g>";
+}
+
+Box CircleBounds(const Style &style, Point center, double radius) {
+  return AddStroke(Box{}
+                       .Extend(Point{center.x - radius, center.y - radius})
+                       .Extend(Point{center.x + radius, center.y + radius}),
+                   style);
+}
+
+Box PolylineBounds(const Style &style, const Point *points, size_t count) {
+  Box box;
+  for (size_t i = 0; i < count; ++i) {
+    box.Extend(points[i]);
+  }
+  return AddStroke(box, style);
+}
+
+Box TextBounds(const Style &style, Point point, Point offset,
+               uint32_t font_size, size_t length) {
+  Point start{point.x + offset.x, point.y + offset.y};
+  double em = font_size;
+  double width = em * static_cast<double>(length);
+  return AddStroke(Box{}
+                       .Extend(Point{start.x, start.y - em})
+                       .Extend(Point{start.x + width, start.y + em / 2}),
+                   style);
+}
+
+Box RectangleBounds(const Style &style, Point point, double width,
+                    double height) {
+  return AddStroke(Box{}
+                       .Extend(point)
+                       .Extend(Point{point.x + width, point.y + height}),
+                   style);
+}
+
+Box Bounds(const Object &object) {
+  return std::visit([](auto &&obj) {
+    return obj.Bounds();
+  }, object);
+}
+
+Box Circle::Bounds() const {
+  return CircleBounds(GetStyle(), center_, radius_);
+}
+
+void Circle::Render(std::ostream &out) const {
+  RenderToStream(*this, out);
+}
+
+void Circle::Render(Writer &out) const {
+  RenderCircle(out, GetStyle(), center_, radius_);
 }
 
 Circle &Circle::SetCenter(Point point) {
@@ -29,21 +231,34 @@ Circle &Circle::SetRadius(double radius) {
   return *this;
 }
 
+Box Polyline::Bounds() const {
+  return PolylineBounds(GetStyle(), points_.data(), points_.size());
+}
+
+Polyline::Polyline(const allocator_type &alloc) : points_(alloc) {}
+
+Polyline::Polyline(const Polyline &other, const allocator_type &alloc)
+    : Figure<Polyline>(other),
+      points_(other.points_, alloc),
+      simplification_(other.simplification_) {}
+
+Polyline::Polyline(Polyline &&other, const allocator_type &alloc)
+    : Figure<Polyline>(std::move(other)),
+      points_(std::move(other.points_), alloc),
+      simplification_(other.simplification_) {}
+
 void Polyline::Render(std::ostream &out) const {
-  out << "<polyline ";
-  RenderProperties(out);
-  out << "points=\"";
-
-  bool first = true;
-  for (auto point : points_) {
-    if (!first) {
-      out << ' ';
-    }
-    first = false;
-    out << point.x << ',' << point.y;
-  }
+  RenderToStream(*this, out);
+}
 
-  out << "\"/>";
+void Polyline::Render(Writer &out) const {
+  Render(out, std::nullopt);
+}
+
+size_t Polyline::Render(Writer &out,
+                        const std::optional<Simplification> &fallback) const {
+  return RenderPolyline(out, GetStyle(), points_.data(), points_.size(),
+                        simplification_ ? simplification_ : fallback);
 }
 
 Polyline &Polyline::AddPoint(Point point) {
@@ -51,21 +266,68 @@ Polyline &Polyline::AddPoint(Point point) {
   return *this;
 }
 
-void Text::Render(std::ostream &out) const {
-  out << "<text ";
-  RenderProperties(out);
-  out << "x=\"" << coords_.x << "\" " <<
-      "y=\"" << coords_.y << "\" " <<
-      "dx=\"" << offset_.x << "\" " <<
-      "dy=\"" << offset_.y << "\" " <<
-      "font-size=\"" << font_size_ << "\"";
-  if (font_family_.has_value()) {
-    out << " font-family=\"" << *font_family_ << "\"";
+Polyline &Polyline::AddPoints(const Point *points, size_t count) {
+  points_.insert(points_.end(), points, points + count);
+  return *this;
+}
+
+Polyline &Polyline::AddPoints(const std::vector<Point> &points) {
+  return AddPoints(points.data(), points.size());
+}
+
+Polyline &Polyline::AddPoints(const double *xs, const double *ys,
+                              size_t count) {
+  // Grows geometrically like insert, so repeated calls stay linear.
+  if (points_.capacity() - points_.size() < count) {
+    points_.reserve(std::max(points_.size() + count, 2 * points_.capacity()));
   }
-  if (font_weight_.has_value()) {
-    out << " font-weight=\"" << *font_weight_ << "\"";
+  for (size_t i = 0; i < count; ++i) {
+    points_.push_back({xs[i], ys[i]});
   }
-  out << '>' << text_ << "</text>";
+  return *this;
+}
+
+Polyline &Polyline::Reserve(size_t count) {
+  points_.reserve(count);
+  return *this;
+}
+
+Polyline &Polyline::SetSimplification(Simplification simplification) {
+  simplification_ = simplification;
+  return *this;
+}
+
+Text::Text(const allocator_type &alloc) : text_(alloc) {}
+
+Text::Text(const Text &other, const allocator_type &alloc)
+    : Figure<Text>(other),
+      coords_(other.coords_),
+      offset_(other.offset_),
+      font_size_(other.font_size_),
+      font_family_(other.font_family_),
+      font_weight_(other.font_weight_),
+      text_(other.text_, alloc) {}
+
+Text::Text(Text &&other, const allocator_type &alloc)
+    : Figure<Text>(std::move(other)),
+      coords_(other.coords_),
+      offset_(other.offset_),
+      font_size_(other.font_size_),
+      font_family_(other.font_family_),
+      font_weight_(other.font_weight_),
+      text_(std::move(other.text_), alloc) {}
+
+Box Text::Bounds() const {
+  return TextBounds(GetStyle(), coords_, offset_, font_size_, text_.size());
+}
+
+void Text::Render(std::ostream &out) const {
+  RenderToStream(*this, out);
+}
+
+void Text::Render(Writer &out) const {
+  RenderText(out, GetStyle(), coords_, offset_, font_size_, font_family_,
+             font_weight_, text_);
 }
 
 Text &Text::SetPoint(Point point) {
@@ -83,24 +345,30 @@ Text &Text::SetFontSize(uint32_t font_size) {
   return *this;
 }
 
-Text &Text::SetFontFamily(const std::string &font_family) {
+Text &Text::SetFontFamily(std::string_view font_family) {
+  return SetFontFamily(Property::Intern(font_family));
+}
+Text &Text::SetFontFamily(Property font_family) {
   font_family_ = font_family;
   return *this;
 }
-Text &Text::SetFontFamily(std::string &&font_family) {
-  font_family_ = std::move(font_family);
+
+Text &Text::SetFontWeight(std::string_view font_weight) {
+  return SetFontWeight(Property::Intern(font_weight));
+}
+Text &Text::SetFontWeight(Property font_weight) {
+  font_weight_ = font_weight;
   return *this;
 }
 
-Text &Text::SetFontWeight(const std::string &font_weight) {
-  font_weight_ = font_weight;
+Text &Text::SetData(std::string_view text) {
+  text_ = text;
   return *this;
 }
-Text &Text::SetFontWeight(std::string &&font_weight) {
-  font_weight_ = std::move(font_weight);
+Text &Text::SetData(const char *text) {
+  text_ = text;
   return *this;
 }
-
 Text &Text::SetData(const std::string &text) {
   text_ = text;
   return *this;
@@ -110,14 +378,16 @@ Text &Text::SetData(std::string &&text) {
   return *this;
 }
 
+Box Rectangle::Bounds() const {
+  return RectangleBounds(GetStyle(), point_, width_, height_);
+}
+
 void Rectangle::Render(std::ostream &out) const {
-  out << "<rect ";
-  out << "x=\"" << point_.x << "\" " <<
-      "y=\"" << point_.y << "\" " <<
-      "width=\"" << width_ << "\" " <<
-      "height=\"" << height_ << "\" ";
-  RenderProperties(out);
-  out << "/>";
+  RenderToStream(*this, out);
+}
+
+void Rectangle::Render(Writer &out) const {
+  RenderRectangle(out, GetStyle(), point_, width_, height_);
 }
 
 Rectangle &Rectangle::SetPoint(Point point) {
@@ -134,31 +404,160 @@ Rectangle &Rectangle::SetHeight(double height) {
   height_ = height;
   return *this;
 }
+
+Path::Path(const allocator_type &alloc) : commands_(alloc), points_(alloc) {}
+
+Path::Path(const Path &other, const allocator_type &alloc)
+    : Figure<Path>(other),
+      commands_(other.commands_, alloc),
+      points_(other.points_, alloc) {}
+
+Path::Path(Path &&other, const allocator_type &alloc)
+    : Figure<Path>(std::move(other)),
+      commands_(std::move(other.commands_), alloc),
+      points_(std::move(other.points_), alloc) {}
+
+Box Path::Bounds() const {
+  // Straight segments never leave the box of their points.
+  return PolylineBounds(GetStyle(), points_.data(), points_.size());
+}
+
+void Path::Render(std::ostream &out) const {
+  RenderToStream(*this, out);
+}
+
+void Path::Render(Writer &out) const {
+  RenderPath(out, GetStyle(), commands_.data(), commands_.size(),
+             points_.data());
+}
+
+Path &Path::MoveTo(Point point) {
+  commands_.push_back(Command::kMoveTo);
+  points_.push_back(point);
+  return *this;
+}
+
+Path &Path::LineTo(Point point) {
+  commands_.push_back(commands_.empty() ? Command::kMoveTo
+                                        : Command::kLineTo);
+  points_.push_back(point);
+  return *this;
+}
+
+Path &Path::Close() {
+  if (!commands_.empty()) {
+    commands_.push_back(Command::kClose);
+  }
+  return *this;
+}
+
+Path &Path::AddPolyline(const Polyline &polyline) {
+  auto &points = polyline.GetPoints();
+  if (points.empty()) {
+    return *this;
+  }
+  commands_.push_back(Command::kMoveTo);
+  commands_.insert(commands_.end(), points.size() - 1, Command::kLineTo);
+  points_.insert(points_.end(), points.begin(), points.end());
+  return *this;
+}
+
+Path &Path::Reserve(size_t count) {
+  commands_.reserve(count);
+  points_.reserve(count);
+  return *this;
+}
+}
+
+svg::Box svg::Section::Bounds() const {
+  return rope_->bounds;
 }
 
 void svg::Section::Render(std::ostream &out) const {
-  out << *rendered_data_;
+  for (auto view : rope_->views) {
+    out.write(view.data(), view.size());
+  }
 }
 
-svg::Section::Section(std::string rendered_data)
-    : rendered_data_(std::make_shared<std::string>(std::move(rendered_data))) {}
+void svg::Section::Render(svg::Writer &out) const {
+  RenderSection(out, rope_->views.data(), rope_->views.size());
+}
+
+uint64_t svg::Section::RenderedSize() const {
+  uint64_t size = 0;
+  for (auto view : rope_->views) {
+    size += view.size();
+  }
+  return size;
+}
+
+svg::Section::Section(std::shared_ptr<const Rope> rope)
+    : rope_(std::move(rope)) {}
+
+svg::SectionBuilder::SectionBuilder(std::pmr::memory_resource *resource)
+    : objects_(resource) {}
 
 svg::SectionBuilder &svg::SectionBuilder::Add(const svg::Object &object) {
-  objects_.push_back(object);
+  EmplaceObject(objects_, object);
   return *this;
 }
 
 svg::SectionBuilder &svg::SectionBuilder::Add(svg::Object &&object) {
-  objects_.push_back(std::move(object));
+  EmplaceObject(objects_, std::move(object));
   return *this;
 }
 
-svg::Section svg::SectionBuilder::Build() {
-  std::ostringstream ss;
+svg::Section svg::SectionBuilder::Build(RenderStats *stats) {
+  // Smaller pieces of nested sections are copied to keep ropes short.
+  constexpr size_t kMinSharedPieceSize = 4 * 1024;
+
+  auto rope = std::make_shared<Section::Rope>();
+  std::string rendered_data;
+  StringSink sink(rendered_data);
+  Writer writer(sink);
+  auto finish_piece = [&] {
+    writer.Flush();
+    if (!rendered_data.empty()) {
+      rope->pieces.push_back(
+          std::make_shared<const std::string>(std::move(rendered_data)));
+      rendered_data.clear();
+    }
+  };
+
   for (auto &object : objects_) {
-    std::visit([&ss](auto &&obj) {
-      obj.Render(ss);
+    std::visit([&](auto &&obj) {
+      using ObjectType = std::decay_t<decltype(obj)>;
+      if constexpr (std::is_same_v<ObjectType, Section>) {
+        // Shared pieces bypass the writer, their bytes are added to stats
+        // here.
+        uint64_t shared_bytes = 0;
+        RenderRecorded<Section>(writer, stats, [&] {
+          for (auto &piece : obj.rope_->pieces) {
+            if (piece->size() < kMinSharedPieceSize) {
+              writer << *piece;
+            } else {
+              finish_piece();
+              rope->pieces.push_back(piece);
+              shared_bytes += piece->size();
+            }
+          }
+          return 0;
+        });
+        if (stats != nullptr) {
+          stats->sections.bytes += shared_bytes;
+        }
+      } else {
+        RenderRecorded<ObjectType>(writer, stats, [&] {
+          return RenderObject(writer, obj, std::nullopt);
+        });
+      }
+      rope->bounds.Extend(obj.Bounds());
     }, object);
   }
-  return Section(ss.str());
+  finish_piece();
+
+  for (auto &piece : rope->pieces) {
+    rope->views.emplace_back(*piece);
+  }
+  return Section(std::move(rope));
 }
@@ -0,0 +1,216 @@
+#include "svg/format.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <system_error>
+
+namespace svg {
+namespace {
+// Exact as doubles, so dividing by them rounds like parsing.
+constexpr double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr uint64_t kIntegerScales[kMaxPrecision + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+    1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000,
+    100000000000000, 1000000000000000};
+// Doubles at or above 2^63 do not convert to int64_t.
+constexpr double kMaxScaled = 9223372036854775808.0;
+// Decimals of 15 significant digits are further apart than the doubles
+// near them, so the one a double reads back from is its shortest form.
+// Scaled to such integers, values lie in [kMinScaled15, kMaxScaled15).
+constexpr double kMinScaled15 = 1e14;
+constexpr double kMaxScaled15 = 1e15;
+constexpr uint64_t kMantissaMask = (uint64_t{1} << 52) - 1;
+constexpr int kExponentBias = 1023;
+constexpr int kMaxBiasedExponent = 0x7ff;
+// Undecided distances closer than this to the half gap between doubles are
+// left to formatting, far above the rounding of the computed distance.
+constexpr double kGapMargin = 1e-9;
+
+size_t FormattedLength(double value) {
+  char buffer[kMaxNumberLength];
+  return std::to_chars(buffer, buffer + kMaxNumberLength, value).ptr - buffer;
+}
+
+// Length of the shortest form of a positive number of count significant
+// digits, the first at 10^exponent: fixed notation, or exponent notation
+// where that is shorter.
+size_t FormLength(int count, int exponent) {
+  int decimals = count - 1 - exponent;
+  int fixed = decimals <= 0 ? count - decimals
+                            : (count > decimals ? count + 1 : decimals + 2);
+  int scientific = count + (count > 1 ? 1 : 0) + 2 +
+      (std::abs(exponent) >= 100 ? 3 : 2);
+  return static_cast<size_t>(std::min(fixed, scientific));
+}
+
+// The exact product of a and b as high + low, by Dekker's splitting, which
+// needs no fused multiply-add.
+void ExactProduct(double a, double b, double &high, double &low) {
+  constexpr double kSplitter = 134217729.0;  // 2^27 + 1
+  high = a * b;
+  double a_split = kSplitter * a;
+  double a_high = a_split - (a_split - a);
+  double a_low = a - a_high;
+  double b_split = kSplitter * b;
+  double b_high = b_split - (b_split - b);
+  double b_low = b - b_high;
+  low = ((a_high * b_high - high) + a_high * b_low + a_low * b_high) +
+      a_low * b_low;
+}
+
+size_t DigitCount(uint64_t value) {
+  size_t count = 1;
+  for (; value >= 10; value /= 10) {
+    ++count;
+  }
+  return count;
+}
+}
+
+char *FormatNumber(char *first, double value) {
+  return std::to_chars(first, first + kMaxNumberLength, value).ptr;
+}
+
+size_t ShortestLength(double value) {
+  if (value == 0) {
+    return std::signbit(value) ? 2 : 1;
+  }
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  int biased_exponent = static_cast<int>(bits >> 52 & kMaxBiasedExponent);
+  uint64_t mantissa = bits & kMantissaMask;
+  // Subnormals, infinities and NaN.
+  if (biased_exponent == 0 || biased_exponent == kMaxBiasedExponent) {
+    return FormattedLength(value);
+  }
+  int binary_exponent = biased_exponent - kExponentBias;
+  double magnitude = std::abs(value);
+
+  // The decimal exponent estimated from the binary one is at most one too
+  // small, in which case the value scales to too many digits.
+  int exponent = binary_exponent >= 0
+      ? binary_exponent * 1233 / 4096
+      : -((-binary_exponent * 1233 + 4095) / 4096);
+  // Scales the value to 15 digits before the point.
+  int scale = 14 - exponent;
+  if (scale < 1 || scale + 1 >= static_cast<int>(std::size(kPowersOfTen))) {
+    return FormattedLength(value);
+  }
+  double scaled = std::nearbyint(magnitude * kPowersOfTen[scale]);
+  if (scaled >= kMaxScaled15) {
+    --scale;
+    scaled = std::nearbyint(magnitude * kPowersOfTen[scale]);
+  }
+  if (scaled < kMinScaled15 || scaled >= kMaxScaled15) {
+    return FormattedLength(value);
+  }
+  size_t sign = value < 0 ? 1 : 0;
+  exponent = 14 - scale;
+  if (scaled / kPowersOfTen[scale] == magnitude) {
+    auto digits = static_cast<uint64_t>(scaled);
+    int count = 15;
+    while (digits % 10 == 0) {
+      digits /= 10;
+      --count;
+    }
+    return sign + FormLength(count, exponent);
+  }
+
+  // 16 digits do if an integer lies within half the gap between doubles of
+  // the value scaled to 16 digits, otherwise it takes 17.
+  double high;
+  double low;
+  ExactProduct(magnitude, kPowersOfTen[scale + 1], high, low);
+  // Below powers of two the gap is smaller than above.
+  if (mantissa == 0 || !(high > kMaxScaled15 && high < kMaxScaled15 * 10)) {
+    return FormattedLength(value);
+  }
+  double fraction = (high - std::nearbyint(high)) + low;
+  double distance = std::abs(fraction - std::nearbyint(fraction));
+  double half_gap = std::ldexp(kPowersOfTen[scale + 1], binary_exponent - 53);
+  if (std::abs(distance - half_gap) < kGapMargin) {
+    return FormattedLength(value);
+  }
+  return sign + FormLength(distance < half_gap ? 16 : 17, exponent);
+}
+
+char *FormatNumber(char *first, double value, int precision) {
+  auto [ptr, ec] = std::to_chars(first, first + kMaxNumberLength, value,
+                                 std::chars_format::fixed, precision);
+  if (ec != std::errc{}) {
+    return FormatNumber(first, value);
+  }
+  return ptr;
+}
+
+char *FormatRounded(char *first, double value, int precision) {
+  double scaled = std::nearbyint(value * kPowersOfTen[precision]);
+  if (!(std::abs(scaled) < kMaxScaled)) {
+    return FormatNumber(first, scaled / kPowersOfTen[precision]);
+  }
+  auto units = static_cast<int64_t>(scaled);
+  if (units == 0) {
+    *first = '0';
+    return first + 1;
+  }
+  if (units < 0) {
+    *first++ = '-';
+  }
+  uint64_t magnitude = units < 0 ? -static_cast<uint64_t>(units) : units;
+  uint64_t fraction = magnitude % kIntegerScales[precision];
+  first = std::to_chars(first, first + kMaxNumberLength,
+                        magnitude / kIntegerScales[precision]).ptr;
+  if (fraction == 0) {
+    return first;
+  }
+
+  int digits = precision;
+  while (fraction % 10 == 0) {
+    fraction /= 10;
+    --digits;
+  }
+  *first++ = '.';
+  for (int i = digits - 1; i >= 0; --i) {
+    first[i] = static_cast<char>('0' + fraction % 10);
+    fraction /= 10;
+  }
+  return first + digits;
+}
+
+size_t RoundedLength(double value, int precision) {
+  double scaled = std::nearbyint(value * kPowersOfTen[precision]);
+  if (!(std::abs(scaled) < kMaxScaled)) {
+    char buffer[kMaxNumberLength];
+    return FormatNumber(buffer, scaled / kPowersOfTen[precision]) - buffer;
+  }
+  auto units = static_cast<int64_t>(scaled);
+  if (units == 0) {
+    return 1;
+  }
+  uint64_t magnitude = units < 0 ? -static_cast<uint64_t>(units) : units;
+  uint64_t fraction = magnitude % kIntegerScales[precision];
+  size_t length = (units < 0 ? 1 : 0) +
+      DigitCount(magnitude / kIntegerScales[precision]);
+  if (fraction == 0) {
+    return length;
+  }
+
+  int digits = precision;
+  while (fraction % 10 == 0) {
+    fraction /= 10;
+    --digits;
+  }
+  return length + 1 + digits;
+}
+
+char *FormatNumber(char *first, uint32_t value) {
+  return std::to_chars(first, first + kMaxNumberLength, value).ptr;
+}
+}
@@ -0,0 +1,85 @@
+#ifndef SVG_FORWARDING_SINK_H_
+#define SVG_FORWARDING_SINK_H_
+
+#include <cstddef>
+#include <exception>
+#include <string_view>
+
+#include "svg/document.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/writer.h"
+
+namespace svg {
+// Passes the output on to a target that may change between documents, so
+// one writer and its buffer serve every document a thread renders.
+class ForwardingSink final : public Sink {
+ public:
+  void SetTarget(Sink *target) {
+    target_ = target;
+  }
+
+  void Write(std::string_view data) override {
+    target_->Write(data);
+  }
+  void WriteVectored(const std::string_view *pieces, size_t count) override {
+    target_->WriteVectored(pieces, count);
+  }
+
+ private:
+  Sink *target_ = nullptr;
+};
+
+// The writer and forwarding sink a thread renders every document with.
+struct ForwardingWriter {
+  ForwardingSink sink;
+  Writer writer{sink};
+
+  // Renders the document to the sink returned by target_of and returns the
+  // error of either instead of throwing it. The buffer is emptied for the
+  // next target even then, the failing sink may fail again.
+  template<typename TargetFn>
+  std::exception_ptr Render(const Document &doc, const RenderOptions &options,
+                            TargetFn &&target_of) {
+    std::exception_ptr error;
+    try {
+      sink.SetTarget(&target_of());
+      doc.Render(writer, options);
+      writer.Flush();
+    } catch (...) {
+      error = std::current_exception();
+      try {
+        writer.Flush();
+      } catch (...) {}
+    }
+    sink.SetTarget(nullptr);
+    return error;
+  }
+};
+
+// Sums the stats and keeps the first error of renders spread over tasks.
+// Callers serialize the calls to Add.
+class RenderResults final {
+ public:
+  explicit RenderResults(RenderStats *stats) : stats_(stats) {}
+
+  void Add(const RenderStats &stats, std::exception_ptr error) {
+    if (stats_ != nullptr) {
+      *stats_ += stats;
+    }
+    if (error && !first_error_) {
+      first_error_ = error;
+    }
+  }
+
+  std::exception_ptr FirstError() const {
+    return first_error_;
+  }
+
+ private:
+  RenderStats *stats_;
+  std::exception_ptr first_error_;
+};
+}
+
+#endif // SVG_FORWARDING_SINK_H_
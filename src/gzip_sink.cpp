@@ -0,0 +1,99 @@
+#include "svg/gzip_sink.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <zlib.h>
+
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+// 15 window bits plus 16 selects the gzip wrapper instead of zlib's own.
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+
+[[noreturn]] void ThrowZlibError(const z_stream &stream, int code) {
+  std::string message = "svg::GzipSink: ";
+  message += stream.msg != nullptr ? stream.msg : zError(code);
+  throw std::runtime_error(message);
+}
+}
+
+GzipSink::GzipSink(Sink &out, int level, size_t buffer_size)
+    : out_(out),
+      stream_(std::make_unique<z_stream>()),
+      buffer_(std::make_unique<unsigned char[]>(buffer_size)),
+      buffer_size_(buffer_size) {
+  if (level < 0 || level > 9) {
+    throw std::invalid_argument("svg::GzipSink: level must be 0-9");
+  }
+  if (buffer_size == 0) {
+    throw std::invalid_argument("svg::GzipSink: buffer size must be positive");
+  }
+  int code = deflateInit2(stream_.get(), level, Z_DEFLATED, kGzipWindowBits,
+                          kMemLevel, Z_DEFAULT_STRATEGY);
+  if (code != Z_OK) {
+    ThrowZlibError(*stream_, code);
+  }
+}
+
+GzipSink::~GzipSink() {
+  try {
+    Finish();
+  } catch (...) {}
+  deflateEnd(stream_.get());
+}
+
+void GzipSink::Write(std::string_view data) {
+  if (finished_) {
+    throw std::logic_error("svg::GzipSink: Write after Finish");
+  }
+  // avail_in is 32-bit, larger blocks are passed in parts.
+  constexpr size_t kMaxInput = std::numeric_limits<uInt>::max();
+  while (!data.empty()) {
+    size_t size = std::min(data.size(), kMaxInput);
+    // zlib never writes through next_in.
+    stream_->next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream_->avail_in = static_cast<uInt>(size);
+    Deflate(Z_NO_FLUSH);
+    data.remove_prefix(size);
+  }
+}
+
+void GzipSink::Finish() {
+  if (!finished_) {
+    finished_ = true;
+    stream_->next_in = nullptr;
+    stream_->avail_in = 0;
+    Deflate(Z_FINISH);
+  }
+}
+
+void GzipSink::Deflate(int flush) {
+  // Runs until all input is consumed, and for Z_FINISH until the trailer is
+  // written, handing every full output buffer to the sink.
+  while (true) {
+    stream_->next_out = buffer_.get();
+    stream_->avail_out = static_cast<uInt>(buffer_size_);
+    int code = deflate(stream_.get(), flush);
+    if (code == Z_STREAM_ERROR) {
+      ThrowZlibError(*stream_, code);
+    }
+    size_t produced = buffer_size_ - stream_->avail_out;
+    if (produced > 0) {
+      out_.Write({reinterpret_cast<const char *>(buffer_.get()), produced});
+    }
+    if (flush == Z_FINISH ? code == Z_STREAM_END
+                          : stream_->avail_in == 0 && stream_->avail_out != 0) {
+      return;
+    }
+  }
+}
+}
@@ -0,0 +1,29 @@
+#ifndef SVG_MAPPED_FILE_H_
+#define SVG_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace svg {
+// Read-only private mapping of a whole file, unmapped on destruction.
+// Throws std::system_error if the file cannot be opened or mapped.
+class MappedFile final {
+ public:
+  explicit MappedFile(const std::string &path);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  // Page aligned, empty for an empty file.
+  std::string_view View() const {
+    return {data_, size_};
+  }
+
+ private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+};
+}
+
+#endif // SVG_MAPPED_FILE_H_
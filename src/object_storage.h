@@ -0,0 +1,31 @@
+#ifndef SVG_OBJECT_STORAGE_H_
+#define SVG_OBJECT_STORAGE_H_
+
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "svg/figures.h"
+
+namespace svg {
+// Appends the object so that the storage it owns comes from the memory
+// resource of objects. std::variant does not propagate allocators itself.
+template<typename ObjectRef>
+void EmplaceObject(std::pmr::vector<Object> &objects, ObjectRef &&object) {
+  std::visit([&objects](auto &&obj) {
+    using ObjectType = std::decay_t<decltype(obj)>;
+    if constexpr (std::uses_allocator_v<ObjectType, Allocator>) {
+      objects.emplace_back(std::in_place_type<ObjectType>,
+                           std::forward<decltype(obj)>(obj),
+                           Allocator(objects.get_allocator()));
+    } else {
+      objects.emplace_back(std::in_place_type<ObjectType>,
+                           std::forward<decltype(obj)>(obj));
+    }
+  }, std::forward<ObjectRef>(object));
+}
+}
+
+#endif // SVG_OBJECT_STORAGE_H_
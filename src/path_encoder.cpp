@@ -0,0 +1,290 @@
+#include "path_encoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+#include "svg/common.h"
+#include "svg/format.h"
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+// Error of a relative coordinate, in units in the last place, that is lost
+// among the rounding of the reader's own arithmetic.
+constexpr double kUlpTolerance = 4;
+
+// Exact as doubles, so scaling by them and back rounds like parsing.
+constexpr double kPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+// Larger scaled values are no longer exact integers.
+constexpr double kMaxExactInteger = 9007199254740992.0;
+// Doubles of smaller scaled values are closer together than a unit of the
+// last digit, so the decimal is the shortest form of its double.
+constexpr double kMaxUniqueScaled = 4503599627370496.0;
+// Tolerance, in units of the last digit, below which two decimals cannot
+// both land on a coordinate: their distance is at least one unit, and
+// they and the doubles they read back as each err by less than the
+// tolerance and a unit in the last place of the double.
+constexpr double kUniqueTolerance = 0.25;
+}
+
+PathEncoder::Number::Number(double number) : value(number) {
+  // Negative zero would cost a sign.
+  if (value == 0) {
+    value = 0;
+  }
+  size = FormatNumber(data, value) - data;
+  Finish();
+}
+
+PathEncoder::Number::Number(double number, int precision) : value(number) {
+  if (value == 0) {
+    value = 0;
+  }
+  if (!(std::abs(value) * kPowersOfTen[precision] < kMaxUniqueScaled)) {
+    size = FormatNumber(data, value) - data;
+    Finish();
+    return;
+  }
+  size = FormatRounded(data, value, precision) - data;
+  // The shortest form is in exponent notation where that is shorter, as
+  // 1e-04 or 1e+05 are.
+  size_t sign = data[0] == '-' ? 1 : 0;
+  size_t digits = 0;
+  size_t trailing_zeros = 0;
+  bool point = false;
+  for (size_t i = sign; i < size; ++i) {
+    if (data[i] == '.') {
+      point = true;
+    } else if (digits > 0 || data[i] != '0') {
+      ++digits;
+      trailing_zeros = data[i] == '0' ? trailing_zeros + 1 : 0;
+    }
+  }
+  if (!point) {
+    digits -= trailing_zeros;
+  }
+  if (digits > 0 && sign + digits + (digits > 1 ? 1 : 0) + 4 < size) {
+    size = FormatNumber(data, value) - data;
+  }
+  Finish();
+}
+
+PathEncoder::Number PathEncoder::Number::Delta(double from,
+                                               int from_decimals, double to,
+                                               const Number &target) {
+  if (from_decimals >= 0 && target.decimals >= 0) {
+    int max_precision = std::min(std::max(from_decimals, target.decimals),
+                                 static_cast<int>(std::size(kPowersOfTen)) - 1);
+    double delta = to - from;
+    double tolerance = kUlpTolerance * std::numeric_limits<double>::epsilon() *
+        std::max(std::abs(from), std::abs(to));
+    // Usually the delta rounded to the digits of the coordinates lands on
+    // the target, and decimals of those digits are too far apart for a
+    // shorter one to land there as well.
+    if (tolerance * kPowersOfTen[max_precision] < kUniqueTolerance) {
+      double scaled = std::nearbyint(delta * kPowersOfTen[max_precision]);
+      double value = scaled / kPowersOfTen[max_precision];
+      if (std::abs(scaled) <= kMaxExactInteger &&
+          std::abs(from + value - to) <= tolerance) {
+        return max_precision <= kMaxPrecision ? Number(value, max_precision)
+                                              : Number(value);
+      }
+    }
+    // The delta rounded to precision digits is the value of the decimal
+    // with that many digits, whose shortest form is no longer. More digits
+    // land closer to the target, so the fewest that land are searched by
+    // halving.
+    std::optional<double> found;
+    int low = 0;
+    int high = max_precision;
+    while (low <= high) {
+      int precision = (low + high) / 2;
+      double scaled = std::nearbyint(delta * kPowersOfTen[precision]);
+      double value = scaled / kPowersOfTen[precision];
+      if (std::abs(scaled) > kMaxExactInteger) {
+        high = precision - 1;
+      } else if (std::abs(from + value - to) <= tolerance) {
+        found = value;
+        high = precision - 1;
+      } else {
+        low = precision + 1;
+      }
+    }
+    if (found.has_value()) {
+      return Number(*found);
+    }
+  }
+  return Number(to - from);
+}
+
+void PathEncoder::Number::Finish() {
+  size_t zero = data[0] == '-' ? 1 : 0;
+  if (size > zero + 1 && data[zero] == '0' && data[zero + 1] == '.') {
+    std::memmove(data + zero, data + zero + 1, size - zero - 1);
+    --size;
+  }
+  std::string_view view(data, size);
+  auto point = view.find('.');
+  if (view.find('e') != std::string_view::npos) {
+    has_point = false;
+    decimals = -1;
+  } else {
+    has_point = point != std::string_view::npos;
+    decimals = has_point ? static_cast<int>(size - point - 1) : 0;
+  }
+}
+
+PathEncoder::PathEncoder(Writer &out) : out_(out) {
+  if (auto precision = out.GetPrecision()) {
+    scale_ = kPowersOfTen[*precision];
+    digits_ = *precision;
+  }
+}
+
+void PathEncoder::MoveTo(Point point) {
+  point = Round(point);
+  Number x = Coordinate(point.x);
+  Number y = Coordinate(point.y);
+  auto dx = Number::Delta(current_.x, decimals_[0], point.x, x);
+  auto dy = Number::Delta(current_.y, decimals_[1], point.y, y);
+  WriteShorter(Command{'M', {&x, &y}, 2}, Command{'m', {&dx, &dy}, 2});
+  if (repeat_ == 'm') {
+    current_.x += dx.value;
+    current_.y += dy.value;
+    repeat_ = 'l';
+  } else {
+    current_ = point;
+    repeat_ = 'L';
+  }
+  start_ = current_;
+  decimals_[0] = start_decimals_[0] = x.decimals;
+  decimals_[1] = start_decimals_[1] = y.decimals;
+}
+
+void PathEncoder::LineTo(Point point) {
+  point = Round(point);
+  Number x = Coordinate(point.x);
+  Number y = Coordinate(point.y);
+  auto dx = Number::Delta(current_.x, decimals_[0], point.x, x);
+  auto dy = Number::Delta(current_.y, decimals_[1], point.y, y);
+  decimals_[0] = x.decimals;
+  decimals_[1] = y.decimals;
+  if (point.y == current_.y) {
+    WriteShorter(Command{'H', {&x}, 1}, Command{'h', {&dx}, 1});
+  } else if (point.x == current_.x) {
+    WriteShorter(Command{'V', {&y}, 1}, Command{'v', {&dy}, 1});
+  } else {
+    WriteShorter(Command{'L', {&x, &y}, 2}, Command{'l', {&dx, &dy}, 2});
+  }
+  // Relative commands move by the written deltas, horizontal and vertical
+  // ones keep the other coordinate.
+  switch (repeat_) {
+    case 'H':
+      current_.x = x.value;
+      break;
+    case 'h':
+      current_.x += dx.value;
+      break;
+    case 'V':
+      current_.y = y.value;
+      break;
+    case 'v':
+      current_.y += dy.value;
+      break;
+    case 'L':
+      current_ = point;
+      break;
+    default:
+      current_.x += dx.value;
+      current_.y += dy.value;
+      break;
+  }
+}
+
+void PathEncoder::Close() {
+  out_ << 'Z';
+  current_ = start_;
+  decimals_[0] = start_decimals_[0];
+  decimals_[1] = start_decimals_[1];
+  repeat_ = 0;
+  after_number_ = false;
+  after_point_ = false;
+}
+
+// Rounded coordinates have at most precision digits after the point, so
+// the shortest forms of them and of their deltas are already rounded.
+Point PathEncoder::Round(Point point) const {
+  if (scale_ == 0) {
+    return point;
+  }
+  point.x = std::nearbyint(point.x * scale_) / scale_;
+  point.y = std::nearbyint(point.y * scale_) / scale_;
+  return point;
+}
+
+PathEncoder::Number PathEncoder::Coordinate(double value) {
+  double scaled = std::nearbyint(value * kPowersOfTen[digits_]);
+  if (scaled / kPowersOfTen[digits_] == value) {
+    return Number(value, digits_);
+  }
+  Number number(value);
+  if (number.decimals > digits_ && number.decimals <= kMaxPrecision) {
+    digits_ = number.decimals;
+  }
+  return number;
+}
+
+bool PathEncoder::NeedsSeparator(bool after_number, bool after_point,
+                                 const Number &number) const {
+  if (!after_number || number.data[0] == '-') {
+    return false;
+  }
+  return !(after_point && number.data[0] == '.');
+}
+
+size_t PathEncoder::Cost(const Command &command) const {
+  bool letter = command.letter != repeat_;
+  size_t cost = letter ? 1 : 0;
+  bool after_number = !letter && after_number_;
+  bool after_point = !letter && after_point_;
+  for (size_t i = 0; i < command.count; ++i) {
+    auto &number = *command.numbers[i];
+    cost += number.size +
+        (NeedsSeparator(after_number, after_point, number) ? 1 : 0);
+    after_number = true;
+    after_point = number.has_point;
+  }
+  return cost;
+}
+
+void PathEncoder::Write(const Command &command) {
+  if (command.letter != repeat_) {
+    out_ << command.letter;
+    after_number_ = false;
+    after_point_ = false;
+  }
+  for (size_t i = 0; i < command.count; ++i) {
+    auto &number = *command.numbers[i];
+    if (NeedsSeparator(after_number_, after_point_, number)) {
+      out_ << ' ';
+    }
+    out_ << std::string_view(number.data, number.size);
+    after_number_ = true;
+    after_point_ = number.has_point;
+  }
+  repeat_ = command.letter;
+}
+
+void PathEncoder::WriteShorter(const Command &absolute,
+                               const Command &relative) {
+  Write(Cost(relative) <= Cost(absolute) ? relative : absolute);
+}
+}
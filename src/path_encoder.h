@@ -0,0 +1,93 @@
+#ifndef SVG_PATH_ENCODER_H_
+#define SVG_PATH_ENCODER_H_
+
+#include <cstddef>
+
+#include "svg/common.h"
+#include "svg/format.h"
+#include "svg/writer.h"
+
+namespace svg {
+// Writes the value of a path "d" attribute command by command in its
+// shortest form: every segment uses the absolute or relative command,
+// including horizontal and vertical lines, that takes fewer bytes, command
+// letters implied by the previous command are left out and numbers are
+// separated only where they would otherwise merge. Points are rounded to
+// the precision of the writer first, if it has one.
+class PathEncoder final {
+ public:
+  explicit PathEncoder(Writer &out);
+
+  void MoveTo(Point point);
+  void LineTo(Point point);
+  void Close();
+
+ private:
+  // A number formatted without its leading zero.
+  struct Number {
+    char data[kMaxNumberLength];
+    size_t size = 0;
+    // What the formatted number reads back as.
+    double value = 0;
+    // Another fraction may follow it without a separator, as in "0.5.5".
+    bool has_point = false;
+    // Digits after the point, -1 in exponent notation.
+    int decimals = 0;
+
+    Number() = default;
+    explicit Number(double number);
+    // A multiple of 10^-precision, at most kMaxPrecision, formatted from
+    // its integer digits like the shortest form of it.
+    Number(double number, int precision);
+    // The shortest number that moves from, a coordinate written with
+    // from_decimals digits after the point, to the coordinate formatted as
+    // target, up to a few units in the last place. Decimal coordinates
+    // rarely differ by a short double, so formatting the difference itself
+    // would print all its rounding noise. Falls back to the difference if
+    // no number as precise as the coordinates will do.
+    static Number Delta(double from, int from_decimals, double to,
+                        const Number &target);
+
+   private:
+    void Finish();
+  };
+
+  // Candidate encoding of one segment.
+  struct Command {
+    char letter;
+    const Number *numbers[2];
+    size_t count;
+  };
+
+  Point Round(Point point) const;
+  // Formats a coordinate from its integer digits if it has at most digits_
+  // decimals, and otherwise learns how many it has.
+  Number Coordinate(double value);
+  bool NeedsSeparator(bool after_number, bool after_point,
+                      const Number &number) const;
+  size_t Cost(const Command &command) const;
+  void Write(const Command &command);
+  // Writes the cheaper of the absolute and relative candidates.
+  void WriteShorter(const Command &absolute, const Command &relative);
+
+  Writer &out_;
+  // 10 to the precision of the writer, 0 without one.
+  double scale_ = 0;
+  // Where the reader of the output is, which may differ from the given
+  // points by rounding of the relative coordinates.
+  Point current_;
+  Point start_;
+  // Most digits after the point of the coordinates so far, up to
+  // kMaxPrecision, or the precision of the writer.
+  int digits_ = 0;
+  // Digits after the point of the last given coordinates.
+  int decimals_[2] = {0, 0};
+  int start_decimals_[2] = {0, 0};
+  // Letter a command may leave out, the one the previous command repeats.
+  char repeat_ = 0;
+  bool after_number_ = false;
+  bool after_point_ = false;
+};
+}
+
+#endif // SVG_PATH_ENCODER_H_
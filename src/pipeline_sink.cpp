@@ -0,0 +1,142 @@
+#include "svg/pipeline_sink.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "svg/writer.h"
+
+namespace svg {
+PipelineSink::PipelineSink(Sink &out, size_t depth, size_t chunk_size)
+    : out_(out), depth_(depth), chunk_size_(chunk_size) {
+  if (depth == 0 || chunk_size == 0) {
+    throw std::invalid_argument(
+        "svg::PipelineSink: depth and chunk size must be positive");
+  }
+  current_.reserve(chunk_size_);
+  thread_ = std::thread([this] {
+    Work();
+  });
+}
+
+PipelineSink::~PipelineSink() {
+  try {
+    Finish();
+  } catch (...) {}
+}
+
+void PipelineSink::Write(std::string_view data) {
+  if (finished_) {
+    throw std::logic_error("svg::PipelineSink: Write after Finish");
+  }
+  {
+    std::lock_guard lock(mutex_);
+    ThrowIfStopped();
+  }
+  while (!data.empty()) {
+    size_t size = std::min(data.size(), chunk_size_ - current_.size());
+    current_.append(data.data(), size);
+    data.remove_prefix(size);
+    if (current_.size() == chunk_size_) {
+      Push();
+    }
+  }
+}
+
+void PipelineSink::Finish() {
+  if (finished_) {
+    std::lock_guard lock(mutex_);
+    ThrowIfStopped();
+    return;
+  }
+  finished_ = true;
+  if (!current_.empty()) {
+    // Fails only once the pipeline has stopped, which is reported below.
+    try {
+      Push();
+    } catch (...) {}
+  }
+  {
+    std::lock_guard lock(mutex_);
+    finishing_ = true;
+  }
+  has_chunk_.notify_one();
+  thread_.join();
+  std::lock_guard lock(mutex_);
+  ThrowIfStopped();
+}
+
+void PipelineSink::Cancel() {
+  {
+    std::lock_guard lock(mutex_);
+    cancelled_ = true;
+    queue_.clear();
+  }
+  has_chunk_.notify_one();
+  has_room_.notify_all();
+}
+
+void PipelineSink::Push() {
+  std::unique_lock lock(mutex_);
+  has_room_.wait(lock, [this] {
+    return queue_.size() < depth_ || error_ || cancelled_;
+  });
+  ThrowIfStopped();
+  queue_.push_back(std::move(current_));
+  if (free_.empty()) {
+    current_ = std::string();
+    current_.reserve(chunk_size_);
+  } else {
+    current_ = std::move(free_.back());
+    free_.pop_back();
+  }
+  lock.unlock();
+  has_chunk_.notify_one();
+}
+
+void PipelineSink::ThrowIfStopped() const {
+  if (cancelled_) {
+    throw PipelineCancelled();
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void PipelineSink::Work() {
+  while (true) {
+    std::string chunk;
+    {
+      std::unique_lock lock(mutex_);
+      has_chunk_.wait(lock, [this] {
+        return !queue_.empty() || finishing_ || cancelled_;
+      });
+      if (cancelled_ || queue_.empty()) {
+        return;
+      }
+      chunk = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    has_room_.notify_one();
+
+    try {
+      out_.Write(chunk);
+    } catch (...) {
+      std::lock_guard lock(mutex_);
+      error_ = std::current_exception();
+      queue_.clear();
+      has_room_.notify_all();
+      return;
+    }
+
+    chunk.clear();
+    std::lock_guard lock(mutex_);
+    free_.push_back(std::move(chunk));
+  }
+}
+}
@@ -0,0 +1,136 @@
+#include "svg/property.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+#include "svg/common.h"
+#include "svg/escape.h"
+#include "svg/format.h"
+
+namespace svg {
+namespace {
+// The pool is split into shards with their own locks so that figures built
+// on several threads rarely wait for each other.
+constexpr size_t kShardCount = 16;
+
+struct Shard {
+  std::mutex mutex;
+  // Deque elements never move, so handles and views stay valid.
+  std::deque<std::string> values;
+  // Original values of the entries changed by escaping, the index keys.
+  std::deque<std::string> keys;
+  std::unordered_map<std::string_view, const std::string *> index;
+};
+
+std::array<Shard, kShardCount> &Shards() {
+  static auto *shards = new std::array<Shard, kShardCount>();
+  return *shards;
+}
+
+// Totals over all shards.
+std::atomic<size_t> pool_entries{0};
+std::atomic<size_t> pool_bytes{0};
+std::atomic<size_t> pool_limit{std::numeric_limits<size_t>::max()};
+}
+
+Property Property::Intern(std::string_view value) {
+  auto hash = std::hash<std::string_view>{}(value);
+  auto &shard = Shards()[hash % kShardCount];
+  std::lock_guard lock(shard.mutex);
+  auto it = shard.index.find(value);
+  if (it == shard.index.end()) {
+    auto escaped = Escape(value);
+    size_t bytes = escaped.size();
+    if (escaped.size() != value.size()) {
+      bytes += value.size();
+    }
+    if (pool_bytes.fetch_add(bytes) + bytes > pool_limit.load()) {
+      pool_bytes.fetch_sub(bytes);
+      throw std::length_error("svg::Property: pool limit exceeded");
+    }
+    auto &stored = shard.values.emplace_back(std::move(escaped));
+    std::string_view key = stored;
+    if (stored.size() != value.size()) {
+      key = shard.keys.emplace_back(value);
+    }
+    it = shard.index.emplace(key, &stored).first;
+    ++pool_entries;
+  }
+  return Property(it->second);
+}
+
+Property::PoolUsage Property::Usage() {
+  PoolUsage usage;
+  usage.entries = pool_entries.load();
+  usage.bytes = pool_bytes.load();
+  return usage;
+}
+
+void Property::SetPoolLimit(size_t bytes) {
+  pool_limit = bytes;
+}
+
+void Property::ClearPool() {
+  for (auto &shard : Shards()) {
+    std::lock_guard lock(shard.mutex);
+    for (auto &value : shard.values) {
+      pool_bytes -= value.size();
+    }
+    for (auto &key : shard.keys) {
+      pool_bytes -= key.size();
+    }
+    pool_entries -= shard.values.size();
+    decltype(shard.index)().swap(shard.index);
+    std::deque<std::string>().swap(shard.values);
+    std::deque<std::string>().swap(shard.keys);
+  }
+}
+
+Property Property::Intern(const Color &color) {
+  if (std::holds_alternative<std::monostate>(color)) {
+    return Property();
+  }
+  if (auto *name = std::get_if<std::string>(&color)) {
+    return Intern(std::string_view(*name));
+  }
+
+  char buf[kMaxNumberLength * 8];
+  char *end = buf;
+  auto append = [&end](std::string_view data) {
+    end = std::copy(data.begin(), data.end(), end);
+  };
+  if (auto *rgb = std::get_if<Rgb>(&color)) {
+    append("rgb(");
+    end = FormatNumber(end, uint32_t{rgb->red});
+    append(",");
+    end = FormatNumber(end, uint32_t{rgb->green});
+    append(",");
+    end = FormatNumber(end, uint32_t{rgb->blue});
+  } else {
+    auto &rgba = std::get<Rgba>(color);
+    append("rgba(");
+    end = FormatNumber(end, uint32_t{rgba.red});
+    append(",");
+    end = FormatNumber(end, uint32_t{rgba.green});
+    append(",");
+    end = FormatNumber(end, uint32_t{rgba.blue});
+    append(",");
+    end = FormatNumber(end, rgba.alpha);
+  }
+  append(")");
+  return Intern(std::string_view(buf, end - buf));
+}
+}
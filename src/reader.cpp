@@ -0,0 +1,605 @@
+#include "svg/reader.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/escape.h"
+#include "svg/figures.h"
+#include "svg/property.h"
+#include "svg/style.h"
+
+namespace svg {
+namespace {
+bool IsSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+bool IsNameChar(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9') || c == '-' || c == ':' || c == '_';
+}
+
+// Recursive descent over the markup written by Document::Render, calling
+// add with every object in document order.
+class Parser final {
+ public:
+  explicit Parser(std::string_view input) : input_(input) {}
+
+  template<typename AddFn>
+  void Parse(const AddFn &add) {
+    SkipSpace();
+    if (Consume("<?xml")) {
+      SkipPast("?>");
+    }
+    SkipSpace();
+    Expect("<svg");
+    if (!SkipAttributes()) {
+      Fail("self-closing svg element");
+    }
+
+    while (true) {
+      SkipSpace();
+      if (Consume("</svg>")) {
+        if (!offsets_.empty()) {
+          Fail("unclosed g element");
+        }
+        break;
+      }
+      if (Consume("</g>")) {
+        if (offsets_.empty()) {
+          Fail("unexpected end of g element");
+        }
+        offsets_.pop_back();
+        continue;
+      }
+      Expect("<");
+      auto name = Name();
+      if (name == "circle") {
+        add(ReadCircle());
+      } else if (name == "polyline") {
+        add(ReadPolyline());
+      } else if (name == "text") {
+        add(ReadText());
+      } else if (name == "rect") {
+        add(ReadRectangle());
+      } else if (name == "path") {
+        add(ReadPath());
+      } else if (name == "style") {
+        ReadStyleSheet();
+      } else if (name == "g") {
+        ReadGroup();
+      } else {
+        Fail("unsupported element");
+      }
+    }
+
+    SkipSpace();
+    if (pos_ != input_.size()) {
+      Fail("data after the svg element");
+    }
+  }
+
+ private:
+  [[noreturn]] void Fail(const char *what) const {
+    throw std::runtime_error(std::string("svg::Read: ") + what +
+                             " at offset " + std::to_string(pos_));
+  }
+
+  void SkipSpace() {
+    while (pos_ < input_.size() && IsSpace(input_[pos_])) {
+      ++pos_;
+    }
+  }
+
+  bool Consume(std::string_view token) {
+    if (input_.compare(pos_, token.size(), token) == 0) {
+      pos_ += token.size();
+      return true;
+    }
+    return false;
+  }
+
+  void Expect(std::string_view token) {
+    if (!Consume(token)) {
+      Fail("unexpected input");
+    }
+  }
+
+  void SkipPast(std::string_view token) {
+    auto end = input_.find(token, pos_);
+    if (end == std::string_view::npos) {
+      Fail("unterminated markup");
+    }
+    pos_ = end + token.size();
+  }
+
+  std::string_view Name() {
+    size_t start = pos_;
+    while (pos_ < input_.size() && IsNameChar(input_[pos_])) {
+      ++pos_;
+    }
+    if (start == pos_) {
+      Fail("expected a name");
+    }
+    return input_.substr(start, pos_ - start);
+  }
+
+  // Reads the next attribute of a start tag. Returns false at the end of
+  // the tag, setting self_closing for "/>".
+  bool NextAttribute(std::string_view &name, std::string_view &value,
+                     bool &self_closing) {
+    SkipSpace();
+    if (Consume("/>")) {
+      self_closing = true;
+      return false;
+    }
+    if (Consume(">")) {
+      self_closing = false;
+      return false;
+    }
+    name = Name();
+    SkipSpace();
+    Expect("=");
+    SkipSpace();
+    Expect("\"");
+    auto *begin = input_.data() + pos_;
+    auto *end = static_cast<const char *>(
+        std::memchr(begin, '"', input_.size() - pos_));
+    if (end == nullptr) {
+      Fail("unterminated attribute value");
+    }
+    value = std::string_view(begin, end - begin);
+    pos_ += value.size() + 1;
+    return true;
+  }
+
+  // Returns whether the tag has content.
+  bool SkipAttributes() {
+    std::string_view name, value;
+    bool self_closing = false;
+    while (NextAttribute(name, value, self_closing)) {}
+    return !self_closing;
+  }
+
+  // Moves a position read inside translated groups to the document.
+  Point Place(Point point) const {
+    if (!offsets_.empty()) {
+      point.x += offsets_.back().x;
+      point.y += offsets_.back().y;
+    }
+    return point;
+  }
+
+  // Opens a group, "translate(x y)" being its only supported transform as
+  // written for sections rendered with an origin.
+  void ReadGroup() {
+    Point offset = Place(Point{});
+    std::string_view name, value;
+    bool self_closing = false;
+    while (NextAttribute(name, value, self_closing)) {
+      if (name == "transform") {
+        auto shift = Translation(value);
+        offset.x += shift.x;
+        offset.y += shift.y;
+      }
+    }
+    if (!self_closing) {
+      offsets_.push_back(offset);
+    }
+  }
+
+  Point Translation(std::string_view value) {
+    const char *pos = value.data();
+    const char *end = value.data() + value.size();
+    auto skip_separators = [&pos, end] {
+      while (pos != end && (IsSpace(*pos) || *pos == ',')) {
+        ++pos;
+      }
+    };
+    auto number = [&](double &result) {
+      skip_separators();
+      auto [ptr, ec] = std::from_chars(pos, end, result);
+      if (ec != std::errc{}) {
+        return false;
+      }
+      pos = ptr;
+      return true;
+    };
+
+    constexpr std::string_view kTranslate = "translate(";
+    if (value.substr(0, kTranslate.size()) != kTranslate) {
+      Fail("unsupported transform");
+    }
+    pos += kTranslate.size();
+    Point shift;
+    if (!number(shift.x)) {
+      Fail("invalid transform");
+    }
+    // The y translation defaults to zero.
+    number(shift.y);
+    skip_separators();
+    if (pos == end || *pos != ')' || pos + 1 != end) {
+      Fail("invalid transform");
+    }
+    return shift;
+  }
+
+  double Number(std::string_view value) {
+    double result = 0;
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(),
+                                     result);
+    if (ec != std::errc{} || ptr != value.data() + value.size()) {
+      Fail("invalid number");
+    }
+    return result;
+  }
+
+  uint32_t Unsigned(std::string_view value) {
+    uint32_t result = 0;
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(),
+                                     result);
+    if (ec != std::errc{} || ptr != value.data() + value.size()) {
+      Fail("invalid number");
+    }
+    return result;
+  }
+
+  // Interns an escaped value, documents repeat few distinct ones.
+  Property Value(std::string_view escaped) {
+    auto it = values_.find(escaped);
+    if (it == values_.end()) {
+      it = values_.emplace(escaped, Property::Intern(Unescape(escaped))).first;
+    }
+    return it->second;
+  }
+  Property Color(std::string_view escaped) {
+    return escaped == "none" ? Property() : Value(escaped);
+  }
+
+  // Applies a presentation attribute, returns false for other names.
+  bool StyleAttribute(std::string_view name, std::string_view value,
+                      Style &style) {
+    if (name == "fill") {
+      style.fill_color = Color(value);
+    } else if (name == "stroke") {
+      style.stroke_color = Color(value);
+    } else if (name == "stroke-width") {
+      style.stroke_width = Number(value);
+    } else if (name == "stroke-linecap") {
+      style.linecap = Value(value);
+    } else if (name == "stroke-linejoin") {
+      style.linejoin = Value(value);
+    } else if (name == "class") {
+      if (value.substr(0, 1) != "s") {
+        Fail("unknown class");
+      }
+      uint32_t id = Unsigned(value.substr(1));
+      if (id >= classes_.size()) {
+        Fail("unknown class");
+      }
+      style = classes_[id];
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  template<typename FigureType>
+  static FigureType &&WithStyle(FigureType &&figure, const Style &style) {
+    figure.SetFillColor(style.fill_color)
+        .SetStrokeColor(style.stroke_color)
+        .SetStrokeWidth(style.stroke_width)
+        .SetStrokeLineCap(style.linecap)
+        .SetStrokeLineJoin(style.linejoin);
+    return std::move(figure);
+  }
+
+  // Reads the attributes of an empty element into its figure, the figure
+  // specific ones through apply(name, value).
+  template<typename FigureType, typename ApplyFn>
+  FigureType ReadEmptyElement(const ApplyFn &apply) {
+    FigureType figure;
+    Style style;
+    std::string_view name, value;
+    bool self_closing = false;
+    while (NextAttribute(name, value, self_closing)) {
+      if (!StyleAttribute(name, value, style)) {
+        apply(figure, name, value);
+      }
+    }
+    if (!self_closing) {
+      Fail("expected an empty element");
+    }
+    return WithStyle(std::move(figure), style);
+  }
+
+  Circle ReadCircle() {
+    Point center;
+    auto circle = ReadEmptyElement<Circle>(
+        [&](Circle &figure, std::string_view name, std::string_view value) {
+          if (name == "cx") {
+            center.x = Number(value);
+          } else if (name == "cy") {
+            center.y = Number(value);
+          } else if (name == "r") {
+            figure.SetRadius(Number(value));
+          }
+        });
+    return std::move(circle.SetCenter(Place(center)));
+  }
+
+  Polyline ReadPolyline() {
+    return ReadEmptyElement<Polyline>(
+        [this](Polyline &polyline, std::string_view name,
+               std::string_view value) {
+          if (name == "points") {
+            ReadPoints(value, polyline);
+          }
+        });
+  }
+
+  void ReadPoints(std::string_view value, Polyline &polyline) {
+    const char *pos = value.data();
+    const char *end = value.data() + value.size();
+    auto skip_space = [&pos, end] {
+      while (pos != end && IsSpace(*pos)) {
+        ++pos;
+      }
+    };
+    skip_space();
+    while (pos != end) {
+      Point point;
+      auto x = std::from_chars(pos, end, point.x);
+      if (x.ec != std::errc{} || x.ptr == end || *x.ptr != ',') {
+        Fail("invalid points");
+      }
+      auto y = std::from_chars(x.ptr + 1, end, point.y);
+      if (y.ec != std::errc{}) {
+        Fail("invalid points");
+      }
+      polyline.AddPoint(Place(point));
+      pos = y.ptr;
+      skip_space();
+    }
+  }
+
+  Rectangle ReadRectangle() {
+    Point point;
+    auto rectangle = ReadEmptyElement<Rectangle>(
+        [&](Rectangle &figure, std::string_view name,
+            std::string_view value) {
+          if (name == "x") {
+            point.x = Number(value);
+          } else if (name == "y") {
+            point.y = Number(value);
+          } else if (name == "width") {
+            figure.SetWidth(Number(value));
+          } else if (name == "height") {
+            figure.SetHeight(Number(value));
+          }
+        });
+    return std::move(rectangle.SetPoint(Place(point)));
+  }
+
+  Path ReadPath() {
+    return ReadEmptyElement<Path>(
+        [this](Path &path, std::string_view name, std::string_view value) {
+          if (name == "d") {
+            ReadPathData(value, path);
+          }
+        });
+  }
+
+  // Reads the straight segment commands, M, L, H, V and Z, absolute or
+  // relative, with implicit repeats and any separators.
+  void ReadPathData(std::string_view value, Path &path) {
+    const char *pos = value.data();
+    const char *end = value.data() + value.size();
+    auto skip_separators = [&pos, end] {
+      while (pos != end && (IsSpace(*pos) || *pos == ',')) {
+        ++pos;
+      }
+    };
+    auto number = [&] {
+      skip_separators();
+      double result = 0;
+      auto [ptr, ec] = std::from_chars(pos, end, result);
+      if (ec != std::errc{}) {
+        Fail("invalid path data");
+      }
+      pos = ptr;
+      return result;
+    };
+
+    Point current, start;
+    char command = 0;
+    skip_separators();
+    while (pos != end) {
+      if (std::isalpha(static_cast<unsigned char>(*pos))) {
+        command = *pos++;
+      } else if (command == 0 || command == 'Z' || command == 'z') {
+        Fail("invalid path data");
+      }
+      bool relative = std::islower(static_cast<unsigned char>(command));
+      Point base = relative ? current : Point{};
+      switch (command) {
+        case 'M':
+        case 'm':
+          current.x = base.x + number();
+          current.y = base.y + number();
+          path.MoveTo(Place(current));
+          start = current;
+          // Pairs after a move are lines.
+          command = relative ? 'l' : 'L';
+          break;
+        case 'L':
+        case 'l':
+          current.x = base.x + number();
+          current.y = base.y + number();
+          path.LineTo(Place(current));
+          break;
+        case 'H':
+        case 'h':
+          current.x = base.x + number();
+          path.LineTo(Place(current));
+          break;
+        case 'V':
+        case 'v':
+          current.y = base.y + number();
+          path.LineTo(Place(current));
+          break;
+        case 'Z':
+        case 'z':
+          path.Close();
+          current = start;
+          break;
+        default:
+          Fail("unsupported path command");
+      }
+      skip_separators();
+    }
+  }
+
+  Text ReadText() {
+    Text text;
+    Style style;
+    Point point, offset;
+    std::string_view name, value;
+    bool self_closing = false;
+    while (NextAttribute(name, value, self_closing)) {
+      if (StyleAttribute(name, value, style)) {
+        continue;
+      }
+      if (name == "x") {
+        point.x = Number(value);
+      } else if (name == "y") {
+        point.y = Number(value);
+      } else if (name == "dx") {
+        offset.x = Number(value);
+      } else if (name == "dy") {
+        offset.y = Number(value);
+      } else if (name == "font-size") {
+        text.SetFontSize(Unsigned(value));
+      } else if (name == "font-family") {
+        text.SetFontFamily(Value(value));
+      } else if (name == "font-weight") {
+        text.SetFontWeight(Value(value));
+      }
+    }
+    text.SetPoint(Place(point)).SetOffset(offset);
+
+    if (!self_closing) {
+      auto end = input_.find('<', pos_);
+      if (end == std::string_view::npos) {
+        Fail("unterminated text");
+      }
+      text.SetData(Unescape(input_.substr(pos_, end - pos_)));
+      pos_ = end;
+      Expect("</text>");
+    }
+    return WithStyle(std::move(text), style);
+  }
+
+  // Reads the classes of a <style> element, ".sN{property:value;...}".
+  void ReadStyleSheet() {
+    if (!SkipAttributes()) {
+      return;
+    }
+    while (true) {
+      SkipSpace();
+      if (Consume("</style>")) {
+        return;
+      }
+      Expect(".s");
+      size_t start = pos_;
+      while (pos_ < input_.size() && input_[pos_] >= '0' &&
+          input_[pos_] <= '9') {
+        ++pos_;
+      }
+      uint32_t id = Unsigned(input_.substr(start, pos_ - start));
+      // Classes are numbered in the order they are written, so the id of a
+      // new one is the number of classes read.
+      if (id > classes_.size()) {
+        Fail("style class out of order");
+      }
+      Expect("{");
+      Style style;
+      while (!Consume("}")) {
+        size_t name_start = pos_;
+        while (pos_ < input_.size() && input_[pos_] != ':' &&
+            input_[pos_] != '}') {
+          ++pos_;
+        }
+        auto name = input_.substr(name_start, pos_ - name_start);
+        Expect(":");
+        size_t value_start = pos_;
+        while (pos_ < input_.size() && input_[pos_] != ';' &&
+            input_[pos_] != '}') {
+          ++pos_;
+        }
+        if (pos_ == input_.size()) {
+          Fail("unterminated style");
+        }
+        if (name == "class" ||
+            !StyleAttribute(name, input_.substr(value_start,
+                                                pos_ - value_start), style)) {
+          Fail("unsupported style property");
+        }
+        Consume(";");
+      }
+      if (id == classes_.size()) {
+        classes_.push_back(style);
+      } else {
+        classes_[id] = style;
+      }
+    }
+  }
+
+  std::string_view input_;
+  size_t pos_ = 0;
+  std::unordered_map<std::string_view, Property> values_;
+  std::vector<Style> classes_;
+  // Total translation of every open group, innermost last.
+  std::vector<Point> offsets_;
+};
+}
+
+Document ReadDocument(std::string_view svg) {
+  Document doc;
+  Parser(svg).Parse([&doc](auto &&object) {
+    doc.Add(std::move(object));
+  });
+  return doc;
+}
+
+Section ReadSection(std::string_view svg) {
+  SectionBuilder builder;
+  Parser(svg).Parse([&builder](auto &&object) {
+    builder.Add(std::move(object));
+  });
+  return builder.Build();
+}
+
+Document ReadDocumentFile(const std::string &path) {
+  MappedFile file(path);
+  return ReadDocument(file.View());
+}
+
+Section ReadSectionFile(const std::string &path) {
+  MappedFile file(path);
+  return ReadSection(file.View());
+}
+}
@@ -0,0 +1,32 @@
+#include "svg/render_stats.h"
+
+namespace svg {
+FigureStats &FigureStats::operator+=(const FigureStats &other) {
+  count += other.count;
+  bytes += other.bytes;
+  points += other.points;
+  time += other.time;
+  return *this;
+}
+
+FigureStats RenderStats::Total() const {
+  FigureStats total;
+  total += circles;
+  total += polylines;
+  total += texts;
+  total += rectangles;
+  total += paths;
+  total += sections;
+  return total;
+}
+
+RenderStats &RenderStats::operator+=(const RenderStats &other) {
+  circles += other.circles;
+  polylines += other.polylines;
+  texts += other.texts;
+  rectangles += other.rectangles;
+  paths += other.paths;
+  sections += other.sections;
+  return *this;
+}
+}
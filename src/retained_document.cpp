@@ -0,0 +1,169 @@
+#include "svg/retained_document.h"
+
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "document_render.h"
+#include "figure_render.h"
+#include "svg/common.h"
+#include "svg/figures.h"
+#include "svg/format.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/simplify.h"
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+constexpr size_t kMarkupWriterCapacity = 4 * 1024;
+
+bool SameSimplification(const std::optional<Simplification> &lhs,
+                        const std::optional<Simplification> &rhs) {
+  if (!lhs.has_value() || !rhs.has_value()) {
+    return lhs.has_value() == rhs.has_value();
+  }
+  return lhs->algorithm == rhs->algorithm && lhs->tolerance == rhs->tolerance;
+}
+}
+
+RetainedDocument::Id RetainedDocument::Add(const Object &object) {
+  return Add(Object(object));
+}
+
+RetainedDocument::Id RetainedDocument::Add(Object &&object) {
+  Id id = slots_.size();
+  slots_.emplace_back(std::move(object));
+  dirty_.push_back(id);
+  return id;
+}
+
+const Object &RetainedDocument::Get(Id id) const {
+  assert(id < slots_.size() && !slots_[id].removed);
+  return slots_[id].object;
+}
+
+Object &RetainedDocument::ModifiedObject(Id id) {
+  assert(id < slots_.size() && !slots_[id].removed);
+  MarkDirty(id);
+  return slots_[id].object;
+}
+
+void RetainedDocument::Remove(Id id) {
+  assert(id < slots_.size());
+  auto &slot = slots_[id];
+  slot.removed = true;
+  slot.object = Object{};
+  std::string().swap(slot.markup);
+}
+
+size_t RetainedDocument::DirtyCount() const {
+  size_t count = 0;
+  for (auto id : dirty_) {
+    if (!slots_[id].removed) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void RetainedDocument::Render(std::ostream &out) {
+  Render(out, RenderOptions{});
+}
+
+void RetainedDocument::Render(Writer &out) {
+  Render(out, RenderOptions{});
+}
+
+void RetainedDocument::Render(std::ostream &out,
+                              const RenderOptions &options) {
+  OstreamSink sink(out);
+  Writer writer(sink);
+  Render(writer, options);
+  writer.Flush();
+}
+
+void RetainedDocument::Render(Writer &out, const RenderOptions &options) {
+  if (options.deduplicate_styles || options.threads > 1 ||
+      options.executor != nullptr) {
+    throw std::invalid_argument(
+        "svg::RetainedDocument: deduplicate_styles, threads and executor "
+        "are not supported");
+  }
+
+  bool same_format =
+      SameSimplification(format_.simplification, options.simplification) &&
+      format_.polylines_as_paths == options.polylines_as_paths &&
+      format_.precision == options.precision &&
+      format_.origin.x == options.origin.x &&
+      format_.origin.y == options.origin.y;
+  if (!same_format) {
+    // Checked before any markup is replaced.
+    if (options.precision.has_value() &&
+        (*options.precision < 0 || *options.precision > kMaxPrecision)) {
+      throw std::invalid_argument("svg::RetainedDocument: invalid precision");
+    }
+    for (Id id = 0; id < slots_.size(); ++id) {
+      MarkDirty(id);
+    }
+    format_.simplification = options.simplification;
+    format_.polylines_as_paths = options.polylines_as_paths;
+    format_.precision = options.precision;
+    format_.origin = options.origin;
+  }
+
+  if (!dirty_.empty()) {
+    std::string scratch;
+    StringSink sink(scratch);
+    Writer writer(sink, kMarkupWriterCapacity);
+    writer.SetPrecision(format_.precision);
+    writer.SetPolylinesAsPaths(format_.polylines_as_paths);
+    writer.SetOrigin(format_.origin);
+    RenderStats stats;
+    for (auto id : dirty_) {
+      auto &slot = slots_[id];
+      if (!slot.removed) {
+        std::visit([&](auto &&obj) {
+          using ObjectType = std::decay_t<decltype(obj)>;
+          RenderRecorded<ObjectType>(
+              writer, options.stats != nullptr ? &stats : nullptr, [&] {
+                return RenderObject(writer, obj, format_.simplification);
+              });
+          slot.bounds = obj.Bounds();
+        }, slot.object);
+        writer.Flush();
+        slot.markup.assign(scratch);
+        scratch.clear();
+      }
+      slot.dirty = false;
+    }
+    dirty_.clear();
+    if (options.stats != nullptr) {
+      *options.stats += stats;
+    }
+  }
+
+  WritePrologue(out, options.view_box);
+  for (auto &slot : slots_) {
+    if (!options.viewport.has_value() ||
+        slot.bounds.Intersects(*options.viewport)) {
+      out << slot.markup;
+    }
+  }
+  out << kEpilogue;
+}
+
+void RetainedDocument::MarkDirty(Id id) {
+  if (!slots_[id].dirty) {
+    slots_[id].dirty = true;
+    dirty_.push_back(id);
+  }
+}
+}
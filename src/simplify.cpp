@@ -0,0 +1,241 @@
+#include "svg/simplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "svg/common.h"
+
+namespace svg {
+namespace {
+
+double TriangleArea(Point a, Point b, Point c) {
+  return std::abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2;
+}
+
+void DouglasPeucker(const Point *points, size_t count, double tolerance,
+                    std::vector<size_t> &kept) {
+  std::vector<uint8_t> keep(count, 0);
+  keep.front() = keep.back() = 1;
+
+  std::vector<std::pair<size_t, size_t>> ranges{{0, count - 1}};
+  double threshold = tolerance * tolerance;
+  while (!ranges.empty()) {
+    auto [first, last] = ranges.back();
+    ranges.pop_back();
+
+    // Squared distances to the segment from a to b are compared scaled by
+    // its squared length, which avoids a division per point. Points
+    // projecting before a or past b are measured to that end, so detours
+    // doubling back along the segment are kept. Coincident ends fall back to
+    // the distance to a.
+    Point a = points[first];
+    double dx = points[last].x - a.x;
+    double dy = points[last].y - a.y;
+    double length = dx * dx + dy * dy;
+    double scale = length > 0 ? length : 1;
+    double max_distance = threshold * scale;
+    size_t farthest = first;
+    for (size_t i = first + 1; i < last; ++i) {
+      double px = points[i].x - a.x;
+      double py = points[i].y - a.y;
+      double dot = px * dx + py * dy;
+      double distance;
+      if (dot <= 0) {
+        distance = (px * px + py * py) * scale;
+      } else if (dot >= length) {
+        double ex = px - dx;
+        double ey = py - dy;
+        distance = (ex * ex + ey * ey) * scale;
+      } else {
+        double cross = px * dy - py * dx;
+        distance = cross * cross;
+      }
+      if (distance > max_distance) {
+        max_distance = distance;
+        farthest = i;
+      }
+    }
+    if (farthest != first) {
+      keep[farthest] = 1;
+      ranges.emplace_back(first, farthest);
+      ranges.emplace_back(farthest, last);
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (keep[i]) {
+      kept.push_back(i);
+    }
+  }
+}
+
+// Binary min-heap of point indices keyed by triangle area. Positions are
+// tracked so that a changed area is sifted in place instead of pushed again,
+// which keeps the heap at one entry per point.
+class AreaHeap {
+ public:
+  // Empties the heap for a polyline of count points, keeping the storage.
+  void Reset(size_t count) {
+    heap_.clear();
+    heap_.reserve(count);
+    positions_.resize(count);
+  }
+
+  bool Empty() const {
+    return heap_.empty();
+  }
+  size_t Top() const {
+    return heap_.front().index;
+  }
+  double TopArea() const {
+    return heap_.front().area;
+  }
+
+  void Push(size_t i, double area) {
+    heap_.push_back({area, i});
+    SiftUp(heap_.size() - 1);
+  }
+
+  void Pop() {
+    auto last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      heap_.front() = last;
+      positions_[last.index] = 0;
+      SiftDown(0);
+    }
+  }
+
+  void Update(size_t i, double area) {
+    size_t position = positions_[i];
+    double old_area = heap_[position].area;
+    heap_[position].area = area;
+    if (area < old_area) {
+      SiftUp(position);
+    } else {
+      SiftDown(position);
+    }
+  }
+
+ private:
+  struct Entry {
+    double area;
+    size_t index;
+  };
+
+  void SiftUp(size_t position) {
+    auto entry = heap_[position];
+    while (position > 0) {
+      size_t parent = (position - 1) / 2;
+      if (heap_[parent].area <= entry.area) {
+        break;
+      }
+      heap_[position] = heap_[parent];
+      positions_[heap_[position].index] = position;
+      position = parent;
+    }
+    heap_[position] = entry;
+    positions_[entry.index] = position;
+  }
+
+  void SiftDown(size_t position) {
+    auto entry = heap_[position];
+    for (;;) {
+      size_t child = 2 * position + 1;
+      if (child >= heap_.size()) {
+        break;
+      }
+      if (child + 1 < heap_.size() &&
+          heap_[child + 1].area < heap_[child].area) {
+        ++child;
+      }
+      if (entry.area <= heap_[child].area) {
+        break;
+      }
+      heap_[position] = heap_[child];
+      positions_[heap_[position].index] = position;
+      position = child;
+    }
+    heap_[position] = entry;
+    positions_[entry.index] = position;
+  }
+
+  std::vector<Entry> heap_;
+  std::vector<size_t> positions_;
+};
+
+void Visvalingam(const Point *points, size_t count, double tolerance,
+                 std::vector<size_t> &kept) {
+  // Reused by the polylines a thread renders, so large traces do not
+  // allocate on every render.
+  thread_local std::vector<size_t> prev;
+  thread_local std::vector<size_t> next;
+  thread_local std::vector<uint8_t> removed;
+  thread_local AreaHeap heap;
+  prev.resize(count);
+  next.resize(count);
+  removed.assign(count, 0);
+  heap.Reset(count);
+
+  for (size_t i = 1; i + 1 < count; ++i) {
+    prev[i] = i - 1;
+    next[i] = i + 1;
+    heap.Push(i, TriangleArea(points[i - 1], points[i], points[i + 1]));
+  }
+
+  double threshold = tolerance * tolerance;
+  while (!heap.Empty() && heap.TopArea() < threshold) {
+    size_t i = heap.Top();
+    double area = heap.TopArea();
+    heap.Pop();
+
+    removed[i] = 1;
+    size_t before = prev[i];
+    size_t after = next[i];
+    next[before] = after;
+    prev[after] = before;
+    // Neighbours never get an area smaller than the point just removed, so
+    // the removal order stays monotonic.
+    if (before != 0) {
+      heap.Update(before, std::max(area, TriangleArea(
+          points[prev[before]], points[before], points[after])));
+    }
+    if (after != count - 1) {
+      heap.Update(after, std::max(area, TriangleArea(
+          points[before], points[after], points[next[after]])));
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (!removed[i]) {
+      kept.push_back(i);
+    }
+  }
+}
+}
+
+void Simplify(const Point *points, size_t count,
+              const Simplification &simplification,
+              std::vector<size_t> &kept) {
+  kept.clear();
+  if (count <= 2 || simplification.tolerance <= 0) {
+    for (size_t i = 0; i < count; ++i) {
+      kept.push_back(i);
+    }
+    return;
+  }
+
+  switch (simplification.algorithm) {
+    case SimplifyAlgorithm::kDouglasPeucker:
+      DouglasPeucker(points, count, simplification.tolerance, kept);
+      break;
+    case SimplifyAlgorithm::kVisvalingam:
+      Visvalingam(points, count, simplification.tolerance, kept);
+      break;
+  }
+}
+}
@@ -0,0 +1,827 @@
+#include "svg/snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "document_render.h"
+#include "figure_render.h"
+#include "mapped_file.h"
+#include "spatial_index.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/escape.h"
+#include "svg/figures.h"
+#include "svg/property.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/simplify.h"
+#include "svg/style.h"
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+constexpr char kMagic[8] = {'S', 'V', 'G', 'S', 'N', 'A', 'P', '\0'};
+// Written in the byte order of the host, a mismatch means the snapshot was
+// saved on a machine of the other byte order.
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint32_t kNoProperty = UINT32_MAX;
+constexpr size_t kAlignment = 8;
+
+// Draw-order entries hold the figure type in the top bits and the record
+// number in the rest.
+enum Kind : uint32_t {
+  kCircle,
+  kPolyline,
+  kText,
+  kRectangle,
+  kPath,
+  kSection,
+  kKindCount,
+};
+constexpr uint32_t kKindShift = 29;
+constexpr uint32_t kPositionMask = (uint32_t{1} << kKindShift) - 1;
+
+enum ArrayId {
+  kOrderArray,
+  kPropertyArray,
+  kPropertyCharArray,
+  kStyleArray,
+  kCircleArray,
+  kPolylineArray,
+  kPointArray,
+  kTextArray,
+  kTextCharArray,
+  kRectangleArray,
+  kPathArray,
+  kPathCommandArray,
+  kSectionArray,
+  kSectionCharArray,
+  kArrayCount,
+};
+
+struct ArrayRef {
+  uint64_t offset;
+  uint64_t count;
+};
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  ArrayRef arrays[kArrayCount];
+};
+
+// Bytes in one of the char arrays.
+struct StringRef {
+  uint64_t offset;
+  uint64_t size;
+};
+
+// Property values are stored escaped, as the pool keeps them.
+struct StyleRecord {
+  double stroke_width;
+  uint32_t fill_color;
+  uint32_t stroke_color;
+  uint32_t linecap;
+  uint32_t linejoin;
+};
+
+struct CircleRecord {
+  Point center;
+  double radius;
+  uint32_t style;
+  uint32_t reserved;
+};
+
+struct PolylineRecord {
+  uint64_t points_begin;
+  uint64_t points_count;
+  uint32_t style;
+  // 0 for none, SimplifyAlgorithm + 1 otherwise.
+  uint32_t simplification;
+  double tolerance;
+};
+
+struct TextRecord {
+  Point point;
+  Point offset;
+  StringRef data;
+  uint32_t font_size;
+  uint32_t style;
+  uint32_t font_family;
+  uint32_t font_weight;
+};
+
+struct RectangleRecord {
+  Point point;
+  double width;
+  double height;
+  uint32_t style;
+  uint32_t reserved;
+};
+
+// Commands are Path::Command values, points are shared with polylines.
+struct PathRecord {
+  uint64_t commands_begin;
+  uint64_t commands_count;
+  uint64_t points_begin;
+  uint64_t points_count;
+  uint32_t style;
+  uint32_t reserved;
+};
+
+struct SectionRecord {
+  StringRef data;
+  Box bounds;
+};
+
+template<typename Record>
+constexpr bool kIsRecord = std::is_trivially_copyable_v<Record> &&
+    alignof(Record) <= kAlignment && sizeof(Record) % alignof(Record) == 0;
+static_assert(kIsRecord<Header> && kIsRecord<StyleRecord> &&
+    kIsRecord<CircleRecord> && kIsRecord<PolylineRecord> &&
+    kIsRecord<TextRecord> && kIsRecord<RectangleRecord> &&
+    kIsRecord<PathRecord> && kIsRecord<SectionRecord> &&
+    kIsRecord<StringRef> && kIsRecord<Point>);
+
+struct PropertyHash {
+  size_t operator()(Property property) const {
+    return property.Hash();
+  }
+};
+
+// Collects the arrays of a snapshot and writes them out.
+class SnapshotBuilder final {
+ public:
+  void Add(const Circle &circle) {
+    AddEntry(kCircle, circles_.size());
+    circles_.push_back(CircleRecord{circle.GetCenter(), circle.GetRadius(),
+                                    AddStyle(circle.GetStyle()), 0});
+  }
+  void Add(const Polyline &polyline) {
+    AddEntry(kPolyline, polylines_.size());
+    auto &points = polyline.GetPoints();
+    auto &simplification = polyline.GetSimplification();
+    polylines_.push_back(PolylineRecord{
+        points_.size(), points.size(), AddStyle(polyline.GetStyle()),
+        simplification.has_value()
+            ? static_cast<uint32_t>(simplification->algorithm) + 1 : 0,
+        simplification.has_value() ? simplification->tolerance : 0});
+    points_.insert(points_.end(), points.begin(), points.end());
+  }
+  void Add(const Text &text) {
+    AddEntry(kText, texts_.size());
+    texts_.push_back(TextRecord{
+        text.GetPoint(), text.GetOffset(), AddString(text_chars_,
+                                                     text.GetData()),
+        text.GetFontSize(), AddStyle(text.GetStyle()),
+        AddProperty(text.GetFontFamily()), AddProperty(text.GetFontWeight())});
+  }
+  void Add(const Rectangle &rectangle) {
+    AddEntry(kRectangle, rectangles_.size());
+    rectangles_.push_back(RectangleRecord{
+        rectangle.GetPoint(), rectangle.GetWidth(), rectangle.GetHeight(),
+        AddStyle(rectangle.GetStyle()), 0});
+  }
+  void Add(const Path &path) {
+    AddEntry(kPath, paths_.size());
+    auto &commands = path.GetCommands();
+    auto &points = path.GetPoints();
+    paths_.push_back(PathRecord{path_commands_.size(), commands.size(),
+                                points_.size(), points.size(),
+                                AddStyle(path.GetStyle()), 0});
+    for (auto command : commands) {
+      path_commands_.push_back(static_cast<uint8_t>(command));
+    }
+    points_.insert(points_.end(), points.begin(), points.end());
+  }
+  void Add(const Section &section) {
+    AddEntry(kSection, sections_.size());
+    std::string data;
+    {
+      StringSink sink(data);
+      Writer writer(sink);
+      section.Render(writer);
+    }
+    sections_.push_back(
+        SectionRecord{AddString(section_chars_, data), section.Bounds()});
+  }
+
+  void Write(Sink &out) const {
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = Snapshot::kVersion;
+    header.byte_order = kByteOrderMark;
+
+    std::string_view arrays[kArrayCount] = {
+        Bytes(order_), Bytes(properties_), Bytes(property_chars_),
+        Bytes(styles_), Bytes(circles_), Bytes(polylines_), Bytes(points_),
+        Bytes(texts_), Bytes(text_chars_), Bytes(rectangles_), Bytes(paths_),
+        Bytes(path_commands_), Bytes(sections_), Bytes(section_chars_)};
+    const size_t counts[kArrayCount] = {
+        order_.size(), properties_.size(), property_chars_.size(),
+        styles_.size(), circles_.size(), polylines_.size(), points_.size(),
+        texts_.size(), text_chars_.size(), rectangles_.size(), paths_.size(),
+        path_commands_.size(), sections_.size(), section_chars_.size()};
+    uint64_t offset = Align(sizeof(Header));
+    for (size_t i = 0; i < kArrayCount; ++i) {
+      header.arrays[i] = {offset, counts[i]};
+      offset = Align(offset + arrays[i].size());
+    }
+
+    static constexpr char kPadding[kAlignment] = {};
+    out.Write({reinterpret_cast<const char *>(&header), sizeof(header)});
+    out.Write({kPadding, Align(sizeof(Header)) - sizeof(Header)});
+    for (auto array : arrays) {
+      out.Write(array);
+      out.Write({kPadding, Align(array.size()) - array.size()});
+    }
+  }
+
+ private:
+  static uint64_t Align(uint64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  template<typename Record>
+  static std::string_view Bytes(const std::vector<Record> &records) {
+    return {reinterpret_cast<const char *>(records.data()),
+            records.size() * sizeof(Record)};
+  }
+
+  void AddEntry(Kind kind, size_t position) {
+    if (position > kPositionMask) {
+      throw std::length_error("svg::SaveSnapshot: too many objects");
+    }
+    order_.push_back(kind << kKindShift | static_cast<uint32_t>(position));
+  }
+
+  static StringRef AddString(std::vector<char> &chars, std::string_view data) {
+    StringRef ref{chars.size(), data.size()};
+    chars.insert(chars.end(), data.begin(), data.end());
+    return ref;
+  }
+
+  uint32_t AddProperty(Property property) {
+    if (!property.HasValue()) {
+      return kNoProperty;
+    }
+    auto [it, inserted] = property_ids_.emplace(
+        property, static_cast<uint32_t>(properties_.size()));
+    if (inserted) {
+      properties_.push_back(AddString(property_chars_, property.View()));
+    }
+    return it->second;
+  }
+
+  uint32_t AddStyle(const Style &style) {
+    auto [it, inserted] =
+        style_ids_.emplace(style, static_cast<uint32_t>(styles_.size()));
+    if (inserted) {
+      styles_.push_back(StyleRecord{
+          style.stroke_width, AddProperty(style.fill_color),
+          AddProperty(style.stroke_color), AddProperty(style.linecap),
+          AddProperty(style.linejoin)});
+    }
+    return it->second;
+  }
+
+  std::vector<uint32_t> order_;
+  std::vector<StringRef> properties_;
+  std::vector<char> property_chars_;
+  std::unordered_map<Property, uint32_t, PropertyHash> property_ids_;
+  std::vector<StyleRecord> styles_;
+  std::unordered_map<Style, uint32_t, StyleHash> style_ids_;
+  std::vector<CircleRecord> circles_;
+  std::vector<PolylineRecord> polylines_;
+  std::vector<Point> points_;
+  std::vector<TextRecord> texts_;
+  std::vector<char> text_chars_;
+  std::vector<RectangleRecord> rectangles_;
+  std::vector<PathRecord> paths_;
+  std::vector<uint8_t> path_commands_;
+  std::vector<SectionRecord> sections_;
+  std::vector<char> section_chars_;
+};
+
+[[noreturn]] void ThrowInvalid(const char *what) {
+  throw std::runtime_error(std::string("svg::Snapshot: ") + what);
+}
+
+// Array of records inside the snapshot bytes.
+template<typename Record>
+struct Array {
+  const Record *data = nullptr;
+  size_t size = 0;
+
+  const Record &operator[](size_t i) const {
+    return data[i];
+  }
+};
+}
+
+struct Snapshot::Data {
+  // Either a mapped file or an 8-byte aligned copy.
+  std::optional<MappedFile> file;
+  std::unique_ptr<uint64_t[]> copy;
+  const char *base = nullptr;
+  size_t size = 0;
+
+  Array<uint32_t> order;
+  Array<StringRef> properties;
+  Array<char> property_chars;
+  Array<StyleRecord> style_records;
+  Array<CircleRecord> circles;
+  Array<PolylineRecord> polylines;
+  Array<Point> points;
+  Array<TextRecord> texts;
+  Array<char> text_chars;
+  Array<RectangleRecord> rectangles;
+  Array<PathRecord> paths;
+  Array<uint8_t> path_commands;
+  Array<SectionRecord> sections;
+  Array<char> section_chars;
+
+  // Decoded on load, indexed like the records.
+  std::vector<Property> interned;
+  std::vector<Style> styles;
+
+  void Parse();
+
+  std::string_view String(const Array<char> &chars, StringRef ref) const {
+    return {chars.data + ref.offset, static_cast<size_t>(ref.size)};
+  }
+  Property Interned(uint32_t id) const {
+    return id == kNoProperty ? Property() : interned[id];
+  }
+  std::optional<Simplification> SimplificationOf(
+      const PolylineRecord &polyline) const {
+    if (polyline.simplification == 0) {
+      return std::nullopt;
+    }
+    return Simplification{
+        static_cast<SimplifyAlgorithm>(polyline.simplification - 1),
+        polyline.tolerance};
+  }
+  // Checked by Parse to hold valid commands only.
+  const Path::Command *CommandsOf(const PathRecord &path) const {
+    return reinterpret_cast<const Path::Command *>(path_commands.data +
+                                                    path.commands_begin);
+  }
+  Box BoundsOf(size_t i) const;
+  void RenderEntry(Writer &out, size_t i, const RenderOptions &options,
+                   RenderStats *stats) const;
+};
+
+void Snapshot::Data::Parse() {
+  Header header;
+  if (size < sizeof(header)) {
+    ThrowInvalid("truncated header");
+  }
+  std::memcpy(&header, base, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    ThrowInvalid("not a snapshot");
+  }
+  if (header.version != kVersion) {
+    ThrowInvalid("unsupported version");
+  }
+  if (header.byte_order != kByteOrderMark) {
+    ThrowInvalid("saved with another byte order");
+  }
+
+  auto map = [&](ArrayId id, auto &array) {
+    using Record = std::remove_reference_t<decltype(*array.data)>;
+    auto ref = header.arrays[id];
+    if (ref.offset % kAlignment != 0 || ref.offset > size ||
+        ref.count > (size - ref.offset) / sizeof(Record)) {
+      ThrowInvalid("array out of bounds");
+    }
+    array.data = reinterpret_cast<const Record *>(base + ref.offset);
+    array.size = ref.count;
+  };
+  map(kOrderArray, order);
+  map(kPropertyArray, properties);
+  map(kPropertyCharArray, property_chars);
+  map(kStyleArray, style_records);
+  map(kCircleArray, circles);
+  map(kPolylineArray, polylines);
+  map(kPointArray, points);
+  map(kTextArray, texts);
+  map(kTextCharArray, text_chars);
+  map(kRectangleArray, rectangles);
+  map(kPathArray, paths);
+  map(kPathCommandArray, path_commands);
+  map(kSectionArray, sections);
+  map(kSectionCharArray, section_chars);
+
+  auto check_string = [](const Array<char> &chars, StringRef ref) {
+    if (ref.offset > chars.size || ref.size > chars.size - ref.offset) {
+      ThrowInvalid("string out of bounds");
+    }
+  };
+  auto check_property = [this](uint32_t id) {
+    if (id != kNoProperty && id >= properties.size) {
+      ThrowInvalid("invalid property");
+    }
+  };
+  auto check_style = [this](uint32_t id) {
+    if (id >= style_records.size) {
+      ThrowInvalid("invalid style");
+    }
+  };
+
+  interned.reserve(properties.size);
+  for (size_t i = 0; i < properties.size; ++i) {
+    check_string(property_chars, properties[i]);
+    interned.push_back(Property::Intern(
+        Unescape(String(property_chars, properties[i]))));
+  }
+  styles.reserve(style_records.size);
+  for (size_t i = 0; i < style_records.size; ++i) {
+    auto &record = style_records[i];
+    for (auto id : {record.fill_color, record.stroke_color, record.linecap,
+                    record.linejoin}) {
+      check_property(id);
+    }
+    styles.push_back(Style{Interned(record.fill_color),
+                           Interned(record.stroke_color),
+                           record.stroke_width, Interned(record.linecap),
+                           Interned(record.linejoin)});
+  }
+
+  const size_t counts[kKindCount] = {circles.size, polylines.size, texts.size,
+                                     rectangles.size, paths.size,
+                                     sections.size};
+  for (size_t i = 0; i < order.size; ++i) {
+    uint32_t kind = order[i] >> kKindShift;
+    if (kind >= kKindCount || (order[i] & kPositionMask) >= counts[kind]) {
+      ThrowInvalid("invalid object");
+    }
+  }
+  for (size_t i = 0; i < circles.size; ++i) {
+    check_style(circles[i].style);
+  }
+  for (size_t i = 0; i < polylines.size; ++i) {
+    auto &polyline = polylines[i];
+    check_style(polyline.style);
+    if (polyline.points_begin > points.size ||
+        polyline.points_count > points.size - polyline.points_begin) {
+      ThrowInvalid("points out of bounds");
+    }
+    if (polyline.simplification > 2) {
+      ThrowInvalid("invalid simplification");
+    }
+  }
+  for (size_t i = 0; i < texts.size; ++i) {
+    auto &text = texts[i];
+    check_style(text.style);
+    check_string(text_chars, text.data);
+    check_property(text.font_family);
+    check_property(text.font_weight);
+  }
+  for (size_t i = 0; i < rectangles.size; ++i) {
+    check_style(rectangles[i].style);
+  }
+  for (size_t i = 0; i < paths.size; ++i) {
+    auto &path = paths[i];
+    check_style(path.style);
+    if (path.commands_begin > path_commands.size ||
+        path.commands_count > path_commands.size - path.commands_begin ||
+        path.points_begin > points.size ||
+        path.points_count > points.size - path.points_begin) {
+      ThrowInvalid("path out of bounds");
+    }
+    // Every command but kClose takes a point.
+    size_t point_count = 0;
+    for (size_t j = 0; j < path.commands_count; ++j) {
+      auto command = path_commands[path.commands_begin + j];
+      if (command > static_cast<uint8_t>(Path::Command::kClose)) {
+        ThrowInvalid("invalid path command");
+      }
+      if (command != static_cast<uint8_t>(Path::Command::kClose)) {
+        ++point_count;
+      }
+    }
+    if (point_count != path.points_count) {
+      ThrowInvalid("invalid path");
+    }
+  }
+  for (size_t i = 0; i < sections.size; ++i) {
+    check_string(section_chars, sections[i].data);
+  }
+}
+
+Box Snapshot::Data::BoundsOf(size_t i) const {
+  uint32_t position = order[i] & kPositionMask;
+  switch (order[i] >> kKindShift) {
+    case kCircle: {
+      auto &circle = circles[position];
+      return CircleBounds(styles[circle.style], circle.center, circle.radius);
+    }
+    case kPolyline: {
+      auto &polyline = polylines[position];
+      return PolylineBounds(styles[polyline.style],
+                            points.data + polyline.points_begin,
+                            polyline.points_count);
+    }
+    case kText: {
+      auto &text = texts[position];
+      return TextBounds(styles[text.style], text.point, text.offset,
+                        text.font_size, text.data.size);
+    }
+    case kRectangle: {
+      auto &rectangle = rectangles[position];
+      return RectangleBounds(styles[rectangle.style], rectangle.point,
+                             rectangle.width, rectangle.height);
+    }
+    case kPath: {
+      auto &path = paths[position];
+      return PolylineBounds(styles[path.style],
+                            points.data + path.points_begin,
+                            path.points_count);
+    }
+    default:
+      return sections[position].bounds;
+  }
+}
+
+void Snapshot::Data::RenderEntry(Writer &out, size_t i,
+                                 const RenderOptions &options,
+                                 RenderStats *stats) const {
+  uint32_t position = order[i] & kPositionMask;
+  switch (order[i] >> kKindShift) {
+    case kCircle:
+      RenderRecorded<Circle>(out, stats, [&] {
+        auto &circle = circles[position];
+        RenderCircle(out, styles[circle.style], circle.center, circle.radius);
+        return 1;
+      });
+      break;
+    case kPolyline:
+      RenderRecorded<Polyline>(out, stats, [&] {
+        auto &polyline = polylines[position];
+        auto simplification = SimplificationOf(polyline);
+        return RenderPolyline(out, styles[polyline.style],
+                              points.data + polyline.points_begin,
+                              polyline.points_count,
+                              simplification ? simplification
+                                             : options.simplification);
+      });
+      break;
+    case kText:
+      RenderRecorded<Text>(out, stats, [&] {
+        auto &text = texts[position];
+        RenderText(out, styles[text.style], text.point, text.offset,
+                   text.font_size, Interned(text.font_family),
+                   Interned(text.font_weight), String(text_chars, text.data));
+        return 1;
+      });
+      break;
+    case kRectangle:
+      RenderRecorded<Rectangle>(out, stats, [&] {
+        auto &rectangle = rectangles[position];
+        RenderRectangle(out, styles[rectangle.style], rectangle.point,
+                        rectangle.width, rectangle.height);
+        return 1;
+      });
+      break;
+    case kPath:
+      RenderRecorded<Path>(out, stats, [&] {
+        auto &path = paths[position];
+        return RenderPath(out, styles[path.style],
+                          CommandsOf(path), path.commands_count,
+                          points.data + path.points_begin);
+      });
+      break;
+    default:
+      RenderRecorded<Section>(out, stats, [&] {
+        auto data = String(section_chars, sections[position].data);
+        RenderSection(out, &data, 1);
+        return 0;
+      });
+      break;
+  }
+}
+
+void SaveSnapshot(const Document &doc, Sink &out) {
+  SnapshotBuilder builder;
+  for (size_t i = 0; i < doc.Size(); ++i) {
+    std::visit([&builder](auto &&obj) {
+      builder.Add(obj);
+    }, doc.Get(i));
+  }
+  builder.Write(out);
+}
+
+void SaveSnapshot(const Section &section, Sink &out) {
+  SnapshotBuilder builder;
+  builder.Add(section);
+  builder.Write(out);
+}
+
+Snapshot Snapshot::Open(const std::string &path) {
+  auto data = std::make_shared<Data>();
+  auto bytes = data->file.emplace(path).View();
+  data->base = bytes.data();
+  data->size = bytes.size();
+  data->Parse();
+  return Snapshot(std::move(data));
+}
+
+Snapshot Snapshot::FromBytes(std::string_view bytes) {
+  auto data = std::make_shared<Data>();
+  data->copy = std::make_unique<uint64_t[]>(
+      (bytes.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  std::memcpy(data->copy.get(), bytes.data(), bytes.size());
+  data->base = reinterpret_cast<const char *>(data->copy.get());
+  data->size = bytes.size();
+  data->Parse();
+  return Snapshot(std::move(data));
+}
+
+Snapshot::Snapshot(std::shared_ptr<const Data> data)
+    : data_(std::move(data)) {}
+
+size_t Snapshot::Size() const {
+  return data_->order.size;
+}
+
+void Snapshot::Render(std::ostream &out) const {
+  Render(out, RenderOptions{});
+}
+
+void Snapshot::Render(Writer &out) const {
+  Render(out, RenderOptions{});
+}
+
+void Snapshot::Render(std::ostream &out, const RenderOptions &options) const {
+  OstreamSink sink(out);
+  Writer writer(sink);
+  Render(writer, options);
+  writer.Flush();
+}
+
+void Snapshot::Render(Writer &out, const RenderOptions &options) const {
+  RenderDocument(
+      out, options, data_->order.size,
+      [this] {
+        return Index();
+      },
+      style_index_,
+      [this, &options](Writer &writer, size_t i, RenderStats *stats) {
+        data_->RenderEntry(writer, i, options, stats);
+      },
+      [this](size_t i) -> const Style * {
+        auto &data = *data_;
+        uint32_t position = data.order[i] & kPositionMask;
+        switch (data.order[i] >> kKindShift) {
+          case kCircle:
+            return &data.styles[data.circles[position].style];
+          case kPolyline:
+            return &data.styles[data.polylines[position].style];
+          case kText:
+            return &data.styles[data.texts[position].style];
+          case kRectangle:
+            return &data.styles[data.rectangles[position].style];
+          case kPath:
+            return &data.styles[data.paths[position].style];
+          default:
+            return nullptr;
+        }
+      });
+}
+
+uint64_t Snapshot::RenderedSize(const RenderOptions &options) const {
+  return MeasureDocument(*this, options);
+}
+
+Document Snapshot::ToDocument() const {
+  auto &data = *data_;
+  auto with_style = [&data](auto &&figure, uint32_t style_id) {
+    auto &style = data.styles[style_id];
+    figure.SetFillColor(style.fill_color)
+        .SetStrokeColor(style.stroke_color)
+        .SetStrokeWidth(style.stroke_width)
+        .SetStrokeLineCap(style.linecap)
+        .SetStrokeLineJoin(style.linejoin);
+    return std::move(figure);
+  };
+
+  Document doc;
+  for (size_t i = 0; i < data.order.size; ++i) {
+    uint32_t position = data.order[i] & kPositionMask;
+    switch (data.order[i] >> kKindShift) {
+      case kCircle: {
+        auto &circle = data.circles[position];
+        doc.Add(with_style(Circle{}.SetCenter(circle.center)
+                               .SetRadius(circle.radius),
+                           circle.style));
+        break;
+      }
+      case kPolyline: {
+        auto &record = data.polylines[position];
+        Polyline polyline;
+        polyline.AddPoints(data.points.data + record.points_begin,
+                           record.points_count);
+        if (auto simplification = data.SimplificationOf(record)) {
+          polyline.SetSimplification(*simplification);
+        }
+        doc.Add(with_style(std::move(polyline), record.style));
+        break;
+      }
+      case kText: {
+        auto &text = data.texts[position];
+        doc.Add(with_style(
+            Text{}.SetPoint(text.point).SetOffset(text.offset)
+                .SetFontSize(text.font_size)
+                .SetFontFamily(data.Interned(text.font_family))
+                .SetFontWeight(data.Interned(text.font_weight))
+                .SetData(data.String(data.text_chars, text.data)),
+            text.style));
+        break;
+      }
+      case kRectangle: {
+        auto &rectangle = data.rectangles[position];
+        doc.Add(with_style(Rectangle{}.SetPoint(rectangle.point)
+                               .SetWidth(rectangle.width)
+                               .SetHeight(rectangle.height),
+                           rectangle.style));
+        break;
+      }
+      case kPath: {
+        auto &record = data.paths[position];
+        auto *commands = data.CommandsOf(record);
+        auto *points = data.points.data + record.points_begin;
+        Path path;
+        path.Reserve(record.commands_count);
+        for (size_t j = 0; j < record.commands_count; ++j) {
+          switch (commands[j]) {
+            case Path::Command::kMoveTo:
+              path.MoveTo(*points++);
+              break;
+            case Path::Command::kLineTo:
+              path.LineTo(*points++);
+              break;
+            case Path::Command::kClose:
+              path.Close();
+              break;
+          }
+        }
+        doc.Add(with_style(std::move(path), record.style));
+        break;
+      }
+      default: {
+        auto &section = data.sections[position];
+        auto rope = std::make_shared<Section::Rope>();
+        rope->pieces.push_back(std::make_shared<const std::string>(
+            data.String(data.section_chars, section.data)));
+        rope->views.emplace_back(*rope->pieces.back());
+        rope->bounds = section.bounds;
+        doc.Add(Section(std::move(rope)));
+        break;
+      }
+    }
+  }
+  return doc;
+}
+
+Section Snapshot::ToSection() const {
+  auto rope = std::make_shared<Section::Rope>();
+  std::string rendered_data;
+  {
+    StringSink sink(rendered_data);
+    Writer writer(sink);
+    for (size_t i = 0; i < data_->order.size; ++i) {
+      data_->RenderEntry(writer, i, RenderOptions{}, nullptr);
+      rope->bounds.Extend(data_->BoundsOf(i));
+    }
+  }
+  rope->pieces.push_back(
+      std::make_shared<const std::string>(std::move(rendered_data)));
+  rope->views.emplace_back(*rope->pieces.back());
+  return Section(std::move(rope));
+}
+
+std::shared_ptr<const SpatialIndex> Snapshot::Index() const {
+  return LazyIndex(index_, [this] {
+    std::vector<Box> boxes;
+    boxes.reserve(data_->order.size);
+    for (size_t i = 0; i < data_->order.size; ++i) {
+      boxes.push_back(data_->BoundsOf(i));
+    }
+    return SpatialIndex(boxes);
+  });
+}
+}
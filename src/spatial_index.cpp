@@ -0,0 +1,117 @@
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "svg/common.h"
+
+namespace svg {
+namespace {
+constexpr uint32_t kHilbertMax = (1u << 16) - 1;
+
+// Position of (x, y) along the Hilbert curve filling a 2^16 x 2^16 grid.
+uint64_t HilbertIndex(uint32_t x, uint32_t y) {
+  uint64_t index = 0;
+  for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+    uint32_t rx = (x & s) ? 1 : 0;
+    uint32_t ry = (y & s) ? 1 : 0;
+    index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+    if (ry == 0) {
+      if (rx == 1) {
+        x = kHilbertMax - x;
+        y = kHilbertMax - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+uint32_t GridCoordinate(double value, double min, double size) {
+  if (size <= 0) {
+    return 0;
+  }
+  return static_cast<uint32_t>(kHilbertMax * ((value - min) / size));
+}
+}
+
+SpatialIndex::SpatialIndex(const std::vector<Box> &boxes) {
+  Box extent;
+  std::vector<size_t> ids;
+  for (size_t id = 0; id < boxes.size(); ++id) {
+    if (!boxes[id].Empty()) {
+      extent.Extend(boxes[id]);
+      ids.push_back(id);
+    }
+  }
+  if (ids.empty()) {
+    return;
+  }
+
+  double width = extent.max.x - extent.min.x;
+  double height = extent.max.y - extent.min.y;
+  std::vector<std::pair<uint64_t, size_t>> order;
+  order.reserve(ids.size());
+  for (auto id : ids) {
+    auto &box = boxes[id];
+    double x = (box.min.x + box.max.x) / 2;
+    double y = (box.min.y + box.max.y) / 2;
+    order.emplace_back(HilbertIndex(GridCoordinate(x, extent.min.x, width),
+                                    GridCoordinate(y, extent.min.y, height)),
+                       id);
+  }
+  std::sort(order.begin(), order.end());
+
+  for (auto &entry : order) {
+    boxes_.push_back(boxes[entry.second]);
+    children_.push_back(entry.second);
+  }
+  level_ends_.push_back(boxes_.size());
+
+  size_t begin = 0;
+  size_t end = boxes_.size();
+  while (end - begin > 1) {
+    for (size_t first = begin; first < end; first += kNodeSize) {
+      Box box;
+      for (size_t i = first; i < std::min(first + kNodeSize, end); ++i) {
+        box.Extend(boxes_[i]);
+      }
+      boxes_.push_back(box);
+      children_.push_back(first);
+    }
+    begin = end;
+    end = boxes_.size();
+    level_ends_.push_back(end);
+  }
+}
+
+void SpatialIndex::Query(const Box &box, std::vector<size_t> &ids) const {
+  if (boxes_.empty()) {
+    return;
+  }
+
+  size_t first_found = ids.size();
+  std::vector<std::pair<size_t, size_t>> stack{
+      {boxes_.size() - 1, level_ends_.size() - 1}};
+  while (!stack.empty()) {
+    auto [node, level] = stack.back();
+    stack.pop_back();
+    if (!boxes_[node].Intersects(box)) {
+      continue;
+    }
+    if (level == 0) {
+      ids.push_back(children_[node]);
+      continue;
+    }
+    size_t first = children_[node];
+    size_t last = std::min(first + kNodeSize, level_ends_[level - 1]);
+    for (size_t child = first; child < last; ++child) {
+      stack.emplace_back(child, level - 1);
+    }
+  }
+  std::sort(ids.begin() + first_found, ids.end());
+}
+}
@@ -0,0 +1,49 @@
+#ifndef SVG_SPATIAL_INDEX_H_
+#define SVG_SPATIAL_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "svg/common.h"
+
+namespace svg {
+// Static packed R-tree: items are sorted along a Hilbert curve and grouped
+// bottom-up into nodes of kNodeSize children, so a query only descends into
+// nodes intersecting the query box.
+class SpatialIndex final {
+ public:
+  // Item ids are positions in boxes, empty boxes are left out.
+  explicit SpatialIndex(const std::vector<Box> &boxes);
+
+  // Appends ids of the items intersecting box in increasing order.
+  void Query(const Box &box, std::vector<size_t> &ids) const;
+
+ private:
+  static constexpr size_t kNodeSize = 16;
+
+  // Nodes of all levels, leaves first and the root last.
+  std::vector<Box> boxes_;
+  // Item id for a leaf, position of the first child for an inner node.
+  std::vector<size_t> children_;
+  // Position past the last node of each level.
+  std::vector<size_t> level_ends_;
+};
+
+// Returns the index a document caches in index, such as its spatial index,
+// first setting it to build() if there is none. Concurrent renders may both
+// build it, the duplicate is dropped.
+template<typename IndexType, typename BuildFn>
+std::shared_ptr<const IndexType> LazyIndex(
+    std::shared_ptr<const IndexType> &index, const BuildFn &build) {
+  auto built = std::atomic_load(&index);
+  if (!built) {
+    built = std::make_shared<const IndexType>(build());
+    std::atomic_store(&index, built);
+  }
+  return built;
+}
+}
+
+#endif // SVG_SPATIAL_INDEX_H_
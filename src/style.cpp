@@ -0,0 +1,134 @@
+#include "svg/style.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+#include "svg/common.h"
+#include "svg/property.h"
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+void HashCombine(size_t &seed, size_t value) {
+  seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+}
+
+// Values of the characters in colors, keywords and functional notations
+// only, so none can end a declaration or rule of the sheet.
+bool IsCssValue(Property property) {
+  for (char c : property.View()) {
+    bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9') || c == ' ' || c == '#' || c == '%' ||
+        c == '.' || c == ',' || c == '(' || c == ')' || c == '+' || c == '-';
+    if (!safe) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsCssStyle(const Style &style) {
+  return IsCssValue(style.fill_color) && IsCssValue(style.stroke_color) &&
+      IsCssValue(style.linecap) && IsCssValue(style.linejoin);
+}
+}
+
+bool operator==(const Style &lhs, const Style &rhs) {
+  return lhs.stroke_width == rhs.stroke_width &&
+      lhs.fill_color == rhs.fill_color &&
+      lhs.stroke_color == rhs.stroke_color &&
+      lhs.linecap == rhs.linecap && lhs.linejoin == rhs.linejoin;
+}
+
+size_t StyleHash::operator()(const Style &style) const {
+  size_t seed = std::hash<double>{}(style.stroke_width);
+  HashCombine(seed, style.fill_color.Hash());
+  HashCombine(seed, style.stroke_color.Hash());
+  HashCombine(seed, style.linecap.Hash());
+  HashCombine(seed, style.linejoin.Hash());
+  return seed;
+}
+
+Box AddStroke(Box box, const Style &style) {
+  if (!box.Empty()) {
+    double half_width = std::abs(style.stroke_width) / 2;
+    box.min.x -= half_width;
+    box.min.y -= half_width;
+    box.max.x += half_width;
+    box.max.y += half_width;
+  }
+  return box;
+}
+
+void RenderStyle(Writer &out, const Style &style) {
+  if (auto id = out.GetStyleClass()) {
+    out << "class=\"s" << *id << "\" ";
+    return;
+  }
+
+  out << "fill=\"";
+  RenderColor(out, style.fill_color);
+  out << "\" stroke=\"";
+  RenderColor(out, style.stroke_color);
+  out << "\" stroke-width=\"" << style.stroke_width << "\" ";
+  if (style.linecap.HasValue())
+    out << "stroke-linecap=\"" << style.linecap << "\" ";
+  if (style.linejoin.HasValue())
+    out << "stroke-linejoin=\"" << style.linejoin << "\" ";
+}
+
+std::optional<uint32_t> StyleSheet::Add(const Style &style) {
+  if (auto it = classes_.find(style); it != classes_.end()) {
+    return it->second;
+  }
+  if (!IsCssStyle(style)) {
+    return std::nullopt;
+  }
+  auto [it, inserted] =
+      classes_.emplace(style, static_cast<uint32_t>(styles_.size()));
+  if (inserted) {
+    styles_.push_back(&it->first);
+  }
+  return it->second;
+}
+
+std::optional<uint32_t> StyleSheet::Find(const Style &style) const {
+  if (auto it = classes_.find(style); it != classes_.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+const Style &StyleSheet::Get(uint32_t id) const {
+  return *styles_[id];
+}
+
+size_t StyleSheet::Size() const {
+  return styles_.size();
+}
+
+void StyleSheet::Render(Writer &out) const {
+  if (styles_.empty()) {
+    return;
+  }
+
+  out << "<style>";
+  for (uint32_t id = 0; id < styles_.size(); ++id) {
+    auto &style = *styles_[id];
+    out << ".s" << id << "{fill:";
+    RenderColor(out, style.fill_color);
+    out << ";stroke:";
+    RenderColor(out, style.stroke_color);
+    out << ";stroke-width:" << style.stroke_width;
+    if (style.linecap.HasValue())
+      out << ";stroke-linecap:" << style.linecap;
+    if (style.linejoin.HasValue())
+      out << ";stroke-linejoin:" << style.linejoin;
+    out << '}';
+  }
+  out << "</style>";
+}
+}
@@ -0,0 +1,74 @@
+#include "svg/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace svg {
+ThreadPool::ThreadPool(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this] {
+      Work();
+    });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Execute(std::function<void()> task) {
+  {
+    std::lock_guard lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  wake_.notify_one();
+}
+
+size_t ThreadPool::Size() const {
+  return workers_.size();
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::Shared(size_t threads) {
+  static std::mutex mutex;
+  static std::shared_ptr<ThreadPool> pool;
+  threads = std::max<size_t>(threads, 1);
+  std::lock_guard lock(mutex);
+  // A replaced pool lives on until the renders using it let it go.
+  if (!pool || pool->Size() < threads) {
+    pool = std::make_shared<ThreadPool>(threads);
+  }
+  return pool;
+}
+
+void ThreadPool::Work() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock lock(mutex_);
+      wake_.wait(lock, [this] {
+        return stopping_ || !tasks_.empty();
+      });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+}
@@ -0,0 +1,156 @@
+#include "svg/tiles.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "forwarding_sink.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/thread_pool.h"
+#include "svg/writer.h"
+
+namespace svg {
+namespace {
+// Tasks per thread, fewer tiles than these make a task each.
+constexpr size_t kTasksPerThread = 4;
+
+class TileRenderer final {
+ public:
+  TileRenderer(const Document &doc, const TileGrid &grid,
+               const TileSinkFn &sink_of, const RenderOptions &options)
+      : doc_(doc), grid_(grid), sink_of_(sink_of), options_(options),
+        results_(options.stats) {}
+
+  // Renders the tiles numbered [first, last) row by row. The task always
+  // ends, an error setting it up is reported like that of a tile.
+  void RenderRange(size_t first, size_t last) {
+    RenderStats stats;
+    std::exception_ptr error;
+    try {
+      Render(first, last, stats, error);
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+
+    std::lock_guard lock(mutex_);
+    results_.Add(stats, error);
+    if (--pending_tasks_ == 0) {
+      tasks_done_.notify_all();
+    }
+  }
+
+  void TaskStarted() {
+    std::lock_guard lock(mutex_);
+    ++pending_tasks_;
+  }
+  void WaitForTasks() {
+    std::unique_lock lock(mutex_);
+    tasks_done_.wait(lock, [this] {
+      return pending_tasks_ == 0;
+    });
+  }
+
+  std::exception_ptr FirstError() const {
+    return results_.FirstError();
+  }
+
+ private:
+  // Keeps the first error of the tiles in error and goes on with the next.
+  void Render(size_t first, size_t last, RenderStats &stats,
+              std::exception_ptr &error) {
+    ForwardingWriter buffer;
+    RenderOptions options = options_;
+    options.threads = 1;
+    options.executor = nullptr;
+    if (options.stats != nullptr) {
+      options.stats = &stats;
+    }
+
+    for (size_t i = first; i < last; ++i) {
+      size_t column = i % grid_.columns;
+      size_t row = i / grid_.columns;
+      Box bounds = grid_.TileBounds(column, row);
+      options.viewport = bounds;
+      options.origin = bounds.min;
+      options.view_box = Box{{0, 0}, {bounds.max.x - bounds.min.x,
+                                      bounds.max.y - bounds.min.y}};
+      auto tile_error = buffer.Render(doc_, options,
+                                      [this, column, row]() -> Sink & {
+                                        return sink_of_(column, row);
+                                      });
+      if (!error) {
+        error = tile_error;
+      }
+    }
+  }
+
+  const Document &doc_;
+  const TileGrid &grid_;
+  const TileSinkFn &sink_of_;
+  const RenderOptions &options_;
+
+  std::mutex mutex_;
+  std::condition_variable tasks_done_;
+  size_t pending_tasks_ = 0;
+  RenderResults results_;
+};
+}
+
+Box TileGrid::TileBounds(size_t column, size_t row) const {
+  Point min{origin.x + tile_width * static_cast<double>(column),
+            origin.y + tile_height * static_cast<double>(row)};
+  return Box{min, {min.x + tile_width, min.y + tile_height}};
+}
+
+void RenderTiles(const Document &doc, const TileGrid &grid,
+                 const TileSinkFn &sink_of, const RenderOptions &options) {
+  size_t tiles = grid.columns * grid.rows;
+  if (tiles == 0) {
+    return;
+  }
+  // Once instead of in every first tile.
+  doc.BuildIndex();
+
+  TileRenderer renderer(doc, grid, sink_of, options);
+  if (options.threads <= 1 && options.executor == nullptr) {
+    renderer.TaskStarted();
+    renderer.RenderRange(0, tiles);
+  } else {
+    std::shared_ptr<ThreadPool> shared_pool;
+    Executor *executor = options.executor;
+    if (executor == nullptr) {
+      shared_pool = ThreadPool::Shared(options.threads);
+      executor = shared_pool.get();
+    }
+    size_t tasks = std::min(
+        tiles, std::max<size_t>(options.threads, 1) * kTasksPerThread);
+    for (size_t i = 0; i < tasks; ++i) {
+      size_t first = tiles * i / tasks;
+      size_t last = tiles * (i + 1) / tasks;
+      renderer.TaskStarted();
+      auto task = [&renderer, first, last] {
+        renderer.RenderRange(first, last);
+      };
+      try {
+        executor->Execute(task);
+      } catch (...) {
+        task();
+      }
+    }
+    renderer.WaitForTasks();
+  }
+
+  if (auto error = renderer.FirstError()) {
+    std::rethrow_exception(error);
+  }
+}
+}
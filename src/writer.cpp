@@ -0,0 +1,199 @@
+#include "svg/writer.h"
+
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "svg/common.h"
+
+namespace svg {
+void Sink::WriteVectored(const std::string_view *pieces, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    Write(pieces[i]);
+  }
+}
+
+StringSink::StringSink(std::string &out) : out_(out) {}
+
+void StringSink::Write(std::string_view data) {
+  out_.append(data);
+}
+
+FdSink::FdSink(int fd) : fd_(fd) {}
+
+void FdSink::Write(std::string_view data) {
+  while (!data.empty()) {
+    auto written = ::write(fd_, data.data(), data.size());
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "svg::FdSink");
+    }
+    data.remove_prefix(written);
+  }
+}
+
+void FdSink::WriteVectored(const std::string_view *pieces, size_t count) {
+  std::vector<iovec> iov;
+  iov.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (!pieces[i].empty()) {
+      iov.push_back({const_cast<char *>(pieces[i].data()), pieces[i].size()});
+    }
+  }
+
+  size_t first = 0;
+  while (first < iov.size()) {
+    auto batch = static_cast<int>(std::min<size_t>(iov.size() - first,
+                                                   IOV_MAX));
+    auto written = ::writev(fd_, iov.data() + first, batch);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "svg::FdSink");
+    }
+    // Skips fully written pieces and trims a partially written one.
+    auto left = static_cast<size_t>(written);
+    while (first < iov.size() && left >= iov[first].iov_len) {
+      left -= iov[first].iov_len;
+      ++first;
+    }
+    if (left > 0) {
+      iov[first].iov_base = static_cast<char *>(iov[first].iov_base) + left;
+      iov[first].iov_len -= left;
+    }
+  }
+}
+
+CallbackSink::CallbackSink(Callback callback)
+    : callback_(std::move(callback)) {}
+
+void CallbackSink::Write(std::string_view data) {
+  callback_(data);
+}
+
+OstreamSink::OstreamSink(std::ostream &out) : out_(out) {}
+
+void OstreamSink::Write(std::string_view data) {
+  out_.write(data.data(), data.size());
+}
+
+void NullSink::Write(std::string_view) {}
+
+void NullSink::WriteVectored(const std::string_view *, size_t) {}
+
+Writer::Writer(Sink &sink, size_t capacity) : Writer(sink, capacity, false) {}
+
+Writer::Writer(Sink &sink, size_t capacity, bool counting)
+    : sink_(sink),
+      owned_buffer_(new char[std::max(capacity, kMaxNumberLength)]),
+      buffer_(owned_buffer_.get()),
+      pos_(buffer_),
+      end_(buffer_ + std::max(capacity, kMaxNumberLength)),
+      counting_(counting) {}
+
+Writer Writer::Measuring(size_t capacity) {
+  // Keeps no state, so all measuring writers share it.
+  static NullSink sink;
+  return Writer(sink, capacity, true);
+}
+
+Writer::Writer(Sink &sink, char *buffer, size_t capacity)
+    : sink_(sink), buffer_(buffer), pos_(buffer), end_(buffer + capacity) {
+  assert(capacity >= kMaxNumberLength);
+}
+
+Writer::~Writer() {
+  try {
+    Flush();
+  } catch (...) {}
+}
+
+void Writer::SetPrecision(std::optional<int> precision) {
+  if (precision.has_value() &&
+      (*precision < 0 || *precision > kMaxPrecision)) {
+    throw std::invalid_argument("svg::Writer: precision out of range");
+  }
+  precision_ = precision.value_or(-1);
+}
+
+void Writer::SetOrigin(const Point &origin) {
+  origin_x_ = origin.x;
+  origin_y_ = origin.y;
+}
+
+Point Writer::GetOrigin() const {
+  return {origin_x_, origin_y_};
+}
+
+void Writer::WriteVectored(const std::string_view *pieces, size_t count) {
+  size_t size = 0;
+  for (size_t i = 0; i < count; ++i) {
+    size += pieces[i].size();
+  }
+  if (counting_) {
+    written_ += size;
+    return;
+  }
+  if (size < kMinVectoredSize || size <= static_cast<size_t>(end_ - pos_)) {
+    for (size_t i = 0; i < count; ++i) {
+      *this << pieces[i];
+    }
+    return;
+  }
+
+  std::vector<std::string_view> views;
+  views.reserve(count + 1);
+  if (pos_ != buffer_) {
+    views.emplace_back(buffer_, pos_ - buffer_);
+  }
+  views.insert(views.end(), pieces, pieces + count);
+  written_ += static_cast<size_t>(pos_ - buffer_) + size;
+  pos_ = buffer_;
+  sink_.WriteVectored(views.data(), views.size());
+}
+
+void Writer::Flush() {
+  Drain();
+}
+
+void Writer::Drain() {
+  auto size = static_cast<size_t>(pos_ - buffer_);
+  pos_ = buffer_;
+  written_ += size;
+  if (size != 0) {
+    sink_.Write({buffer_, size});
+  }
+}
+
+void Writer::WriteSlow(std::string_view data) {
+  if (counting_) {
+    written_ += data.size();
+    return;
+  }
+  Drain();
+  if (data.size() >= static_cast<size_t>(end_ - pos_)) {
+    written_ += data.size();
+    sink_.Write(data);
+    return;
+  }
+  std::memcpy(pos_, data.data(), data.size());
+  pos_ += data.size();
+}
+}
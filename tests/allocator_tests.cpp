@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "svg/document.h"
+#include "svg/figures.h"
+
+namespace {
+// Counts the bytes currently allocated through it.
+class CountingResource final : public std::pmr::memory_resource {
+ public:
+  size_t allocated = 0;
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    allocated += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+    allocated -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+void Fill(svg::Document &doc) {
+  svg::Polyline polyline;
+  for (int i = 0; i < 100; ++i) {
+    polyline.AddPoint({1.0 * i, 2.0 * i});
+  }
+  doc.Add(polyline);
+  doc.Add(svg::Text{}.SetData(std::string(100, 'a')));
+  doc.Add(svg::SectionBuilder{}.Add(polyline).Build());
+}
+}
+
+TEST(TestAllocator, TestDocument) {
+  svg::Document heap_doc;
+  Fill(heap_doc);
+  std::ostringstream want;
+  heap_doc.Render(want);
+
+  CountingResource resource;
+  std::ostringstream copy_output;
+  {
+    svg::Document doc(&resource);
+    Fill(doc);
+    EXPECT_GE(resource.allocated, 100 * sizeof(svg::Point) + 100)
+              << "Points and text live in the resource";
+
+    std::ostringstream got;
+    doc.Render(got);
+    EXPECT_EQ(want.str(), got.str());
+
+    svg::Document copy = doc;
+    size_t allocated = resource.allocated;
+    copy.Add(svg::Circle{});
+    EXPECT_EQ(allocated, resource.allocated) << "Copies use the default heap";
+    copy.Render(copy_output);
+  }
+  EXPECT_EQ(0u, resource.allocated);
+}
+
+TEST(TestAllocator, TestSectionBuilder) {
+  std::pmr::monotonic_buffer_resource arena;
+  svg::Section section = [&arena] {
+    svg::SectionBuilder builder(&arena);
+    builder.Add(svg::Polyline{}.AddPoint({1, 2}).AddPoint({3, 4}));
+    builder.Add(svg::Text{}.SetData("label"));
+    return builder.Build();
+  }();
+  arena.release();
+
+  std::ostringstream got;
+  section.Render(got);
+  EXPECT_EQ("<polyline fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+            "points=\"1,2 3,4\"/>"
+            "<text fill=\"none\" stroke=\"none\" stroke-width=\"1\" x=\"0\" "
+            "y=\"0\" dx=\"0\" dy=\"0\" font-size=\"1\">label</text>",
+            got.str());
+}
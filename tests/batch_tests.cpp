@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/batch.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/thread_pool.h"
+#include "svg/writer.h"
+
+namespace {
+// Small, empty and larger than a task documents mixed.
+std::vector<svg::Document> Documents() {
+  std::vector<size_t> sizes{10, 0, 300, 1, svg::kBatchTaskObjects * 2, 50};
+  for (size_t i = 0; i < 200; ++i) {
+    sizes.push_back(i % 37);
+  }
+  sizes.push_back(svg::kBatchTaskObjects + 1);
+
+  std::vector<svg::Document> docs;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    docs.push_back(svg_test::SceneDocument(sizes[i], static_cast<uint32_t>(i)));
+  }
+  return docs;
+}
+
+std::string Render(const svg::Document &doc,
+                   const svg::RenderOptions &options) {
+  std::string out;
+  svg::StringSink sink(out);
+  svg::Writer writer(sink);
+  doc.Render(writer, options);
+  writer.Flush();
+  return out;
+}
+}
+
+TEST(TestBatch, TestRender) {
+  struct TestCase {
+    std::string name;
+    svg::RenderOptions options;
+  };
+
+  svg::ThreadPool pool(3);
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Serial", .options = {}},
+      TestCase{.name = "Own pool", .options = {.threads = 4}},
+      TestCase{.name = "Executor",
+               .options = {.threads = 3, .executor = &pool}},
+      TestCase{.name = "Options", .options = {.deduplicate_styles = true,
+                                              .precision = 1,
+                                              .threads = 4}},
+  };
+
+  auto docs = Documents();
+  for (auto &[name, options] : test_cases) {
+    std::vector<std::string> outs(docs.size());
+    std::vector<std::unique_ptr<svg::StringSink>> sinks;
+    std::vector<svg::BatchItem> items;
+    for (size_t i = 0; i < docs.size(); ++i) {
+      sinks.push_back(std::make_unique<svg::StringSink>(outs[i]));
+      items.push_back({&docs[i], sinks.back().get()});
+    }
+    std::vector<int> done(docs.size());
+    svg::RenderBatch(items, options,
+                     [&done](size_t i, std::exception_ptr error) {
+                       EXPECT_FALSE(error);
+                       ++done[i];
+                     });
+
+    auto serial = options;
+    serial.threads = 1;
+    serial.executor = nullptr;
+    for (size_t i = 0; i < docs.size(); ++i) {
+      EXPECT_EQ(outs[i], Render(docs[i], serial)) << name << " " << i;
+      EXPECT_EQ(done[i], 1) << name << " " << i;
+    }
+  }
+}
+
+TEST(TestBatch, TestErrors) {
+  auto docs = Documents();
+  std::vector<std::string> outs(docs.size());
+  std::vector<std::unique_ptr<svg::Sink>> sinks;
+  std::vector<svg::BatchItem> items;
+  for (size_t i = 0; i < docs.size(); ++i) {
+    if (i == 2 || i == 4) {
+      sinks.push_back(std::make_unique<svg_test::FailingSink>());
+    } else {
+      sinks.push_back(std::make_unique<svg::StringSink>(outs[i]));
+    }
+    items.push_back({&docs[i], sinks.back().get()});
+  }
+
+  std::vector<size_t> failed;
+  svg::RenderBatch(items, {.threads = 4},
+                   [&failed](size_t i, std::exception_ptr error) {
+                     if (error) {
+                       failed.push_back(i);
+                     }
+                   });
+  std::sort(failed.begin(), failed.end());
+  EXPECT_EQ(failed, (std::vector<size_t>{2, 4}));
+
+  // Without a callback the batch finishes and then throws.
+  outs.assign(docs.size(), "");
+  EXPECT_THROW(svg::RenderBatch(items, {.threads = 4}), std::runtime_error);
+  for (size_t i = 0; i < docs.size(); ++i) {
+    if (i != 2 && i != 4) {
+      EXPECT_EQ(outs[i], Render(docs[i], {})) << i;
+    }
+  }
+
+  // Nor does a throwing callback stop it.
+  size_t calls = 0;
+  EXPECT_THROW(svg::RenderBatch(items, {.threads = 4},
+                                [&calls](size_t, std::exception_ptr error) {
+                                  ++calls;
+                                  if (error) {
+                                    std::rethrow_exception(error);
+                                  }
+                                }),
+               std::runtime_error);
+  EXPECT_EQ(calls, docs.size());
+}
+
+TEST(TestBatch, TestStats) {
+  auto docs = Documents();
+  std::vector<size_t> sizes(docs.size());
+  std::vector<std::unique_ptr<svg::CallbackSink>> sinks;
+  std::vector<svg::BatchItem> items;
+  size_t objects = 0;
+  for (size_t i = 0; i < docs.size(); ++i) {
+    sinks.push_back(std::make_unique<svg::CallbackSink>(
+        [&size = sizes[i]](std::string_view data) {
+          size += data.size();
+        }));
+    items.push_back({&docs[i], sinks.back().get()});
+    objects += docs[i].Size();
+  }
+
+  svg::RenderStats stats;
+  svg::RenderBatch(items, {.threads = 4, .stats = &stats});
+  size_t bytes = 0;
+  for (size_t size : sizes) {
+    bytes += size - Render(svg::Document{}, {}).size();
+  }
+  EXPECT_EQ(stats.Total().count, objects);
+  EXPECT_EQ(stats.Total().bytes, bytes);
+}
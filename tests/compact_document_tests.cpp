@@ -0,0 +1,87 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/common.h"
+#include "svg/compact_document.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/simplify.h"
+
+TEST(TestCompactDocument, TestSameOutput) {
+  struct TestCase {
+    std::string name;
+    size_t count;
+    svg::RenderOptions options;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Empty",
+          .count = 0,
+      },
+      TestCase{
+          .name = "Default",
+          .count = 100,
+      },
+      TestCase{
+          .name = "Viewport",
+          .count = 1000,
+          .options = {.viewport = svg::Box{{1000, 1000}, {4000, 3000}}},
+      },
+      TestCase{
+          .name = "Simplification",
+          .count = 100,
+          .options = {.simplification = svg::Simplification{
+              svg::SimplifyAlgorithm::kDouglasPeucker, 0.1}},
+      },
+      TestCase{
+          .name = "Deduplicated styles",
+          .count = 100,
+          .options = {.deduplicate_styles = true},
+      },
+      TestCase{
+          .name = "Parallel",
+          .count = 5000,
+          .options = {.threads = 4},
+      },
+  };
+
+  // Sections, simplified polylines and escaped text the scene lacks.
+  auto features = svg_test::FeatureScene();
+  for (auto &[name, count, options] : test_cases) {
+    auto objects = svg_test::Scene(count);
+    for (size_t i = 0; count > 0 && i < features.Size(); ++i) {
+      objects.push_back(features.Get(i));
+    }
+    svg::Document doc;
+    svg::CompactDocument compact;
+    for (auto &object : objects) {
+      doc.Add(object);
+      compact.Add(object);
+    }
+    EXPECT_EQ(objects.size(), compact.Size()) << name;
+
+    std::ostringstream want, got;
+    doc.Render(want, options);
+    compact.Render(got, options);
+    EXPECT_EQ(want.str(), got.str()) << name;
+  }
+}
+
+TEST(TestCompactDocument, TestAddAfterViewportRender) {
+  svg::CompactDocument compact;
+  compact.Add(svg::Circle{}.SetCenter({10, 10}));
+  svg::RenderOptions options{.viewport = svg::Box{{0, 0}, {100, 100}}};
+  std::ostringstream first;
+  compact.Render(first, options);
+
+  compact.Add(svg::Circle{}.SetCenter({20, 20}));
+  std::ostringstream second;
+  compact.Render(second, options);
+  EXPECT_NE(first.str(), second.str()) << "Add drops the index";
+}
@@ -0,0 +1,85 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/escape.h"
+#include "svg/figures.h"
+#include "svg/property.h"
+#include "svg/writer.h"
+
+TEST(TestEscape, TestEscape) {
+  struct TestCase {
+    std::string name;
+    std::string data;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Empty", .data = "", .want = ""},
+      TestCase{.name = "Clean", .data = "Central Station",
+               .want = "Central Station"},
+      TestCase{.name = "All special", .data = "&<>\"'",
+               .want = "&amp;&lt;&gt;&quot;&apos;"},
+      TestCase{.name = "Mixed", .data = "Fish & Chips <Bar>",
+               .want = "Fish &amp; Chips &lt;Bar&gt;"},
+      TestCase{.name = "Past the first block",
+               .data = "0123456789abcdefghij\"quoted\"",
+               .want = "0123456789abcdefghij&quot;quoted&quot;"},
+      TestCase{.name = "Block boundary",
+               .data = std::string(15, 'a') + "&" + std::string(16, 'b') + "<",
+               .want = std::string(15, 'a') + "&amp;" + std::string(16, 'b') +
+                   "&lt;"},
+      TestCase{.name = "Non-ASCII", .data = "Caf\xc3\xa9 'A'",
+               .want = "Caf\xc3\xa9 &apos;A&apos;"},
+  };
+
+  for (auto &[name, data, want] : test_cases) {
+    EXPECT_EQ(want, svg::Escape(data)) << name;
+    EXPECT_EQ(data, svg::Unescape(want)) << name;
+
+    std::string got;
+    {
+      svg::StringSink sink(got);
+      svg::Writer writer(sink);
+      svg::WriteEscaped(writer, data);
+    }
+    EXPECT_EQ(want, got) << name;
+  }
+}
+
+TEST(TestEscape, TestUnescapeOtherReferences) {
+  EXPECT_EQ("&#38; & &amp x<", svg::Unescape("&#38; & &amp x&lt;"));
+}
+
+TEST(TestEscape, TestFindSpecialChar) {
+  for (size_t size = 0; size < 40; ++size) {
+    for (size_t pos = 0; pos <= size; ++pos) {
+      std::string data(size, 'x');
+      if (pos < size) {
+        data[pos] = '<';
+      }
+      EXPECT_EQ(pos, svg::FindSpecialChar(data)) << size << " " << pos;
+    }
+  }
+}
+
+TEST(TestEscape, TestFigures) {
+  std::ostringstream out;
+  svg::Text{}
+      .SetData("a < b & \"c\"")
+      .SetFontFamily("Tom & Jerry")
+      .SetFillColor(std::string("url(\"#g\")"))
+      .Render(out);
+  EXPECT_EQ("<text fill=\"url(&quot;#g&quot;)\" stroke=\"none\" "
+            "stroke-width=\"1\" x=\"0\" y=\"0\" dx=\"0\" dy=\"0\" "
+            "font-size=\"1\" font-family=\"Tom &amp; Jerry\">"
+            "a &lt; b &amp; &quot;c&quot;</text>",
+            out.str());
+
+  EXPECT_TRUE(svg::Property::Intern("Tom & Jerry") ==
+      svg::Property::Intern("Tom & Jerry"));
+  EXPECT_TRUE(svg::Property::Intern("Tom & Jerry") !=
+      svg::Property::Intern("Tom &amp; Jerry"));
+}
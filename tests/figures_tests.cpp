@@ -1,4 +1,5 @@
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -8,6 +9,9 @@
 #include "svg/common.h"
 #include "svg/document.h"
 #include "svg/figures.h"
+#include "svg/format.h"
+#include "svg/render_options.h"
+#include "svg/writer.h"
 
 #define PREFIX "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"                \
                "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">"
@@ -295,6 +299,41 @@ TEST(TestFigures, TestPolyline) {
                       "stroke-width=\"1\" points=\"-13.4,12.7 "
                       "41.9231,-11.1111\"/>")
       },
+      TestCase{
+          .name = "Add points(array)",
+          .polyline = [] {
+            svg::Point points[] = {{1, 2}, {3, 4}, {5.5, 6}};
+            svg::Polyline polyline;
+            polyline.AddPoint({0, 0}).AddPoints(points, 3);
+            return polyline;
+          }(),
+          .want = SVG_DOC(
+                      "<polyline fill=\"none\" stroke=\"none\" "
+                      "stroke-width=\"1\" points=\"0,0 1,2 3,4 5.5,6\"/>")
+      },
+      TestCase{
+          .name = "Add points(vector)",
+          .polyline = svg::Polyline{}
+              .Reserve(3)
+              .AddPoints(std::vector<svg::Point>{{1, 2}, {3, 4}})
+              .AddPoint({5, 6}),
+          .want = SVG_DOC(
+                      "<polyline fill=\"none\" stroke=\"none\" "
+                      "stroke-width=\"1\" points=\"1,2 3,4 5,6\"/>")
+      },
+      TestCase{
+          .name = "Add points(coordinate arrays)",
+          .polyline = [] {
+            double xs[] = {1, 3, 5};
+            double ys[] = {2, 4, 6};
+            svg::Polyline polyline;
+            polyline.AddPoints(xs, ys, 3);
+            return polyline;
+          }(),
+          .want = SVG_DOC(
+                      "<polyline fill=\"none\" stroke=\"none\" "
+                      "stroke-width=\"1\" points=\"1,2 3,4 5,6\"/>")
+      },
       TestCase{
           .name = "Set all",
           .polyline = svg::Polyline{}
@@ -324,6 +363,25 @@ TEST(TestFigures, TestPolyline) {
   }
 }
 
+// Repeated bulk additions reallocate a logarithmic number of times.
+TEST(TestFigures, TestPolylineGrowth) {
+  svg::Point point{1, 2};
+  double x = 1, y = 2;
+  svg::Polyline from_points, from_coordinates;
+  size_t point_growths = 0, coordinate_growths = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto capacity = from_points.GetPoints().capacity();
+    from_points.AddPoints(&point, 1);
+    point_growths += from_points.GetPoints().capacity() != capacity;
+
+    capacity = from_coordinates.GetPoints().capacity();
+    from_coordinates.AddPoints(&x, &y, 1);
+    coordinate_growths += from_coordinates.GetPoints().capacity() != capacity;
+  }
+  EXPECT_LE(point_growths, 20u);
+  EXPECT_LE(coordinate_growths, 20u);
+}
+
 TEST(TestFigures, TestText) {
   struct TestCase {
     std::string name;
@@ -883,3 +941,127 @@ TEST(TestDocument, TestDocument) {
     EXPECT_EQ(want, got) << name;
   }
 }
+
+TEST(TestDocument, TestStreamingDocument) {
+  struct TestCase {
+    std::string name;
+    std::vector<svg::Object> objects;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Empty Document",
+          .objects = {},
+          .want = SVG_DOC("")
+      },
+      TestCase{
+          .name = "Different objects",
+          .objects = {svg::Circle{}, svg::Polyline{}, svg::Text{},
+                      svg::SectionBuilder{}.Add(svg::Polyline{}).Build(),
+                      svg::Rectangle{}},
+          .want = SVG_DOC(
+                      DEFAULT_CIRCLE DEFAULT_POLYLINE DEFAULT_TEXT
+                      DEFAULT_POLYLINE DEFAULT_RECTANGLE),
+      },
+  };
+
+  for (auto &[name, objects, want] : test_cases) {
+    std::string got;
+    svg::StringSink sink(got);
+    svg::Writer writer(sink);
+    {
+      svg::StreamingDocument doc(writer);
+      for (auto &object : objects) {
+        doc.Add(object);
+      }
+    }
+    writer.Flush();
+
+    EXPECT_EQ(want, got) << name;
+  }
+
+  std::string got;
+  svg::StringSink sink(got);
+  svg::Writer writer(sink);
+  svg::StreamingDocument doc(writer);
+  doc.Add(svg::Circle{}).Add(svg::Rectangle{});
+  doc.Finish();
+  doc.Finish();
+  EXPECT_THROW(doc.Add(svg::Circle{}), std::logic_error);
+  EXPECT_THROW(doc.Add(svg::Object{svg::Circle{}}), std::logic_error);
+  writer.Flush();
+
+  EXPECT_EQ(SVG_DOC(DEFAULT_CIRCLE DEFAULT_RECTANGLE), got) << "Figures";
+}
+
+TEST(TestDocument, TestPrecision) {
+  struct TestCase {
+    std::string name;
+    svg::RenderOptions options;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Shortest",
+          .options = {},
+          .want = SVG_DOC(
+              "<circle fill=\"none\" stroke=\"none\" stroke-width=\"0.125\" "
+              "cx=\"1.005\" cy=\"-0.25\" r=\"2.5\"/>"
+              "<polyline fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+              "points=\"0.3333,1.5 2,2.9999\"/>"
+              "<text fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+              "x=\"0.75\" y=\"0\" dx=\"0\" dy=\"0\" font-size=\"1\"></text>"
+              "<rect x=\"0.49\" y=\"0\" width=\"10.01\" height=\"0\" "
+              "fill=\"none\" stroke=\"none\" stroke-width=\"1\" />")
+      },
+      TestCase{
+          .name = "Two digits",
+          .options = {.precision = 2},
+          .want = SVG_DOC(
+              "<circle fill=\"none\" stroke=\"none\" stroke-width=\"0.12\" "
+              "cx=\"1\" cy=\"-0.25\" r=\"2.5\"/>"
+              "<polyline fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+              "points=\"0.33,1.5 2,3\"/>"
+              "<text fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+              "x=\"0.75\" y=\"0\" dx=\"0\" dy=\"0\" font-size=\"1\"></text>"
+              "<rect x=\"0.49\" y=\"0\" width=\"10.01\" height=\"0\" "
+              "fill=\"none\" stroke=\"none\" stroke-width=\"1\" />")
+      },
+      TestCase{
+          .name = "Integers",
+          .options = {.precision = 0},
+          .want = SVG_DOC(
+              "<circle fill=\"none\" stroke=\"none\" stroke-width=\"0\" "
+              "cx=\"1\" cy=\"0\" r=\"2\"/>"
+              "<polyline fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+              "points=\"0,2 2,3\"/>"
+              "<text fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+              "x=\"1\" y=\"0\" dx=\"0\" dy=\"0\" font-size=\"1\"></text>"
+              "<rect x=\"0\" y=\"0\" width=\"10\" height=\"0\" "
+              "fill=\"none\" stroke=\"none\" stroke-width=\"1\" />")
+      },
+  };
+
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({1.005, -0.25}).SetRadius(2.5)
+              .SetStrokeWidth(0.125));
+  doc.Add(svg::Polyline{}.AddPoint({0.3333, 1.5}).AddPoint({2, 2.9999}));
+  doc.Add(svg::Text{}.SetPoint({0.75, 0}));
+  doc.Add(svg::Rectangle{}.SetPoint({0.49, 0}).SetWidth(10.01));
+
+  for (auto &[name, options, want] : test_cases) {
+    std::ostringstream ss;
+    doc.Render(ss, options);
+    EXPECT_EQ(ss.str(), want) << name;
+  }
+}
+
+TEST(TestDocument, TestPrecisionRange) {
+  svg::Document doc;
+  std::ostringstream ss;
+  EXPECT_THROW(doc.Render(ss, {.precision = -1}), std::invalid_argument);
+  EXPECT_THROW(doc.Render(ss, {.precision = svg::kMaxPrecision + 1}),
+               std::invalid_argument);
+}
@@ -0,0 +1,136 @@
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/format.h"
+
+TEST(TestFormat, TestShortest) {
+  struct TestCase {
+    std::string name;
+    double value;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Zero", .value = 0.0, .want = "0"},
+      TestCase{.name = "Integer", .value = 42.0, .want = "42"},
+      TestCase{.name = "Negative", .value = -13.0, .want = "-13"},
+      TestCase{.name = "Fraction", .value = 3.005, .want = "3.005"},
+      TestCase{.name = "More than 6 digits",
+               .value = 12.345678901,
+               .want = "12.345678901"},
+      TestCase{.name = "Inexact sum", .value = 0.1 + 0.2,
+               .want = "0.30000000000000004"},
+      TestCase{.name = "Large", .value = 1e22, .want = "1e+22"},
+  };
+
+  for (auto &[name, value, want] : test_cases) {
+    char buf[svg::kMaxNumberLength];
+    auto got = std::string(buf, svg::FormatNumber(buf, value));
+
+    EXPECT_EQ(want, got) << name;
+    EXPECT_EQ(value, std::stod(got)) << name;
+    EXPECT_EQ(want.size(), svg::ShortestLength(value)) << name;
+  }
+
+  // Lengths of 15, 16 and 17 significant digits, exponent notation, powers
+  // of two and values left to formatting.
+  std::mt19937_64 gen(42);
+  std::uniform_real_distribution<double> coordinate(-10000, 10000);
+  std::vector<double> values{-0.0, 1.0 / 3, 0.1 + 0.2, 123456.789, 1e-5,
+                             0.0001, 100000, 1e23, 0.125, 1024,
+                             5e-324, 1.7976931348623157e308,
+                             std::numeric_limits<double>::infinity()};
+  for (int i = 0; i < 10000; ++i) {
+    values.push_back(coordinate(gen));
+    values.push_back(std::round(values.back() * 100) / 100);
+  }
+  for (double value : values) {
+    char buf[svg::kMaxNumberLength];
+    EXPECT_EQ(svg::FormatNumber(buf, value) - buf,
+              static_cast<ptrdiff_t>(svg::ShortestLength(value)))
+        << value;
+  }
+}
+
+TEST(TestFormat, TestFixed) {
+  struct TestCase {
+    std::string name;
+    double value;
+    int precision;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Round down", .value = 1.234, .precision = 2,
+               .want = "1.23"},
+      TestCase{.name = "Round up", .value = 1.236, .precision = 2,
+               .want = "1.24"},
+      TestCase{.name = "Pad with zeros", .value = 1.5, .precision = 3,
+               .want = "1.500"},
+      TestCase{.name = "Zero precision", .value = 7.6, .precision = 0,
+               .want = "8"},
+      TestCase{.name = "Too large for fixed", .value = 1e300, .precision = 2,
+               .want = "1e+300"},
+  };
+
+  for (auto &[name, value, precision, want] : test_cases) {
+    char buf[svg::kMaxNumberLength];
+    auto got = std::string(buf, svg::FormatNumber(buf, value, precision));
+
+    EXPECT_EQ(want, got) << name;
+  }
+}
+
+TEST(TestFormat, TestRounded) {
+  struct TestCase {
+    std::string name;
+    double value;
+    int precision;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Round down", .value = 1.234, .precision = 2,
+               .want = "1.23"},
+      TestCase{.name = "Round up", .value = 1.236, .precision = 2,
+               .want = "1.24"},
+      TestCase{.name = "Trailing zeros", .value = 1.5, .precision = 3,
+               .want = "1.5"},
+      TestCase{.name = "Integer", .value = 7.6, .precision = 0,
+               .want = "8"},
+      TestCase{.name = "Rounds to integer", .value = 2.9999, .precision = 2,
+               .want = "3"},
+      TestCase{.name = "Leading fraction zeros", .value = -0.0625,
+               .precision = 4, .want = "-0.0625"},
+      TestCase{.name = "Negative zero", .value = -0.001, .precision = 2,
+               .want = "0"},
+      TestCase{.name = "Inexact sum", .value = 0.1 + 0.2, .precision = 15,
+               .want = "0.3"},
+      TestCase{.name = "Too large for integers", .value = 1e22,
+               .precision = 2, .want = "1e+22"},
+  };
+
+  for (auto &[name, value, precision, want] : test_cases) {
+    char buf[svg::kMaxNumberLength];
+    auto got = std::string(buf, svg::FormatRounded(buf, value, precision));
+
+    EXPECT_EQ(want, got) << name;
+    EXPECT_EQ(want.size(), svg::RoundedLength(value, precision)) << name;
+  }
+
+  for (int precision = 0; precision <= svg::kMaxPrecision; ++precision) {
+    for (double value : {0.0, 0.5, -1.0, 9.99, 10.0, -123.456789, 1e15,
+                         -9.5e-7, 4294967296.125, 1e300}) {
+      char buf[svg::kMaxNumberLength];
+      EXPECT_EQ(svg::FormatRounded(buf, value, precision) - buf,
+                static_cast<ptrdiff_t>(svg::RoundedLength(value, precision)))
+          << value << " at " << precision;
+    }
+  }
+}
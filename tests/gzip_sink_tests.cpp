@@ -0,0 +1,109 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/gzip_sink.h"
+#include "svg/writer.h"
+
+namespace {
+std::string Gunzip(const std::string &data) {
+  z_stream stream{};
+  EXPECT_EQ(Z_OK, inflateInit2(&stream, 15 + 16));
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+
+  std::string result;
+  char buffer[4096];
+  int code;
+  do {
+    stream.next_out = reinterpret_cast<Bytef *>(buffer);
+    stream.avail_out = sizeof(buffer);
+    code = inflate(&stream, Z_NO_FLUSH);
+    result.append(buffer, sizeof(buffer) - stream.avail_out);
+  } while (code == Z_OK);
+  EXPECT_EQ(Z_STREAM_END, code);
+  EXPECT_EQ(0u, stream.avail_in) << "No bytes after the gzip member";
+  inflateEnd(&stream);
+  return result;
+}
+
+}
+
+TEST(TestGzipSink, TestRoundTrip) {
+  struct TestCase {
+    std::string name;
+    int level;
+    size_t buffer_size;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Default", .level = 6, .buffer_size = 64 * 1024},
+      TestCase{.name = "Stored", .level = 0, .buffer_size = 64 * 1024},
+      TestCase{.name = "Fastest", .level = 1, .buffer_size = 64 * 1024},
+      TestCase{.name = "Best", .level = 9, .buffer_size = 64 * 1024},
+      TestCase{.name = "Tiny buffer", .level = 6, .buffer_size = 7},
+  };
+
+  auto doc = svg_test::SceneDocument(10000);
+  std::string want;
+  {
+    svg::StringSink sink(want);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+  }
+
+  for (auto &[name, level, buffer_size] : test_cases) {
+    std::string compressed;
+    size_t max_block = 0;
+    svg::CallbackSink sink([&](std::string_view data) {
+      compressed.append(data);
+      max_block = std::max(max_block, data.size());
+    });
+    svg::GzipSink gzip(sink, level, buffer_size);
+    svg::Writer writer(gzip);
+    doc.Render(writer);
+    writer.Flush();
+    gzip.Finish();
+
+    EXPECT_EQ(want, Gunzip(compressed)) << name;
+    EXPECT_LE(max_block, buffer_size) << name;
+    if (level != 0) {
+      EXPECT_LT(compressed.size(), want.size() / 2) << name;
+    }
+  }
+}
+
+TEST(TestGzipSink, TestEmpty) {
+  std::string compressed;
+  {
+    svg::StringSink sink(compressed);
+    svg::GzipSink gzip(sink);
+  }
+  EXPECT_EQ("", Gunzip(compressed)) << "The destructor finishes the stream";
+}
+
+TEST(TestGzipSink, TestInvalidLevel) {
+  std::string compressed;
+  svg::StringSink sink(compressed);
+  EXPECT_THROW(svg::GzipSink(sink, 10), std::invalid_argument);
+  EXPECT_THROW(svg::GzipSink(sink, -1), std::invalid_argument);
+  EXPECT_THROW(svg::GzipSink(sink, 6, 0), std::invalid_argument);
+}
+
+TEST(TestGzipSink, TestWriteAfterFinish) {
+  std::string compressed;
+  svg::StringSink sink(compressed);
+  svg::GzipSink gzip(sink);
+  gzip.Write("<svg>");
+  gzip.Finish();
+
+  EXPECT_THROW(gzip.Write("</svg>"), std::logic_error);
+  EXPECT_EQ("<svg>", Gunzip(compressed));
+}
@@ -0,0 +1,78 @@
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/thread_pool.h"
+
+namespace {
+std::string Render(const svg::Document &doc,
+                   const svg::RenderOptions &options) {
+  std::ostringstream ss;
+  doc.Render(ss, options);
+  return ss.str();
+}
+
+// Runs every task on the calling thread.
+class InlineExecutor final : public svg::Executor {
+ public:
+  void Execute(std::function<void()> task) override {
+    task();
+  }
+};
+}
+
+TEST(TestParallel, TestRender) {
+  auto doc = svg_test::SceneDocument(5000);
+  auto want = Render(doc, {});
+
+  svg::ThreadPool pool(3);
+  InlineExecutor inline_executor;
+
+  struct TestCase {
+    std::string name;
+    svg::RenderOptions options;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Two threads", .options = {.threads = 2}},
+      TestCase{.name = "Eight threads", .options = {.threads = 8}},
+      TestCase{.name = "External pool",
+               .options = {.threads = 3, .executor = &pool}},
+      TestCase{.name = "Inline executor",
+               .options = {.threads = 4, .executor = &inline_executor}},
+  };
+
+  for (auto &[name, options] : test_cases) {
+    EXPECT_EQ(want, Render(doc, options)) << name;
+  }
+
+  svg::Box viewport{{1000, 1000}, {6000, 4000}};
+  EXPECT_EQ(Render(doc, {.viewport = viewport}),
+            Render(doc, {.viewport = viewport, .threads = 4}))
+            << "Viewport";
+}
+
+TEST(TestParallel, TestSmallDocument) {
+  auto doc = svg_test::SceneDocument(10);
+
+  EXPECT_EQ(Render(doc, {}), Render(doc, {.threads = 8}));
+}
+
+TEST(TestParallel, TestSharedPool) {
+  auto pool = svg::ThreadPool::Shared(2);
+  EXPECT_GE(pool->Size(), 2u);
+  EXPECT_EQ(pool, svg::ThreadPool::Shared(1)) << "Reused when large enough";
+  EXPECT_EQ(pool, svg::ThreadPool::Shared(2));
+
+  auto larger = svg::ThreadPool::Shared(pool->Size() + 1);
+  EXPECT_GT(larger->Size(), pool->Size());
+  EXPECT_EQ(larger, svg::ThreadPool::Shared(2));
+}
@@ -0,0 +1,265 @@
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/common.h"
+#include "svg/compact_document.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/reader.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/snapshot.h"
+#include "svg/writer.h"
+
+#define PREFIX "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"                \
+               "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">"
+#define POSTFIX "</svg>"
+#define SVG_DOC(body) PREFIX body POSTFIX
+#define PATH(d) "<path fill=\"none\" stroke=\"none\" stroke-width=\"1\" " \
+                "d=\"" d "\"/>"
+
+namespace {
+template<typename DocumentType>
+std::string Render(const DocumentType &doc,
+                   const svg::RenderOptions &options = {}) {
+  std::ostringstream ss;
+  doc.Render(ss, options);
+  return ss.str();
+}
+
+std::vector<svg::Point> Route(size_t count, uint32_t seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<double> step(-5, 5);
+  std::vector<svg::Point> points;
+  svg::Point point{500, 500};
+  for (size_t i = 0; i < count; ++i) {
+    point.x = std::round((point.x + step(random)) * 100) / 100;
+    point.y = std::round((point.y + step(random)) * 100) / 100;
+    points.push_back(point);
+  }
+  return points;
+}
+}
+
+TEST(TestPath, TestRender) {
+  struct TestCase {
+    std::string name;
+    svg::Path path;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Empty",
+          .path = svg::Path{},
+          .want = SVG_DOC(PATH(""))
+      },
+      TestCase{
+          .name = "Implicit lines",
+          .path = svg::Path{}.MoveTo({1000, 1000}).LineTo({1001, 1002})
+              .LineTo({1003, 1001}),
+          .want = SVG_DOC(PATH("m1000 1000 1 2 2-1"))
+      },
+      TestCase{
+          .name = "Horizontal and vertical",
+          .path = svg::Path{}.MoveTo({10, 20}).LineTo({30, 20})
+              .LineTo({30, 40}).Close(),
+          .want = SVG_DOC(PATH("m10 20h20v20Z"))
+      },
+      TestCase{
+          .name = "Absolute when shorter",
+          .path = svg::Path{}.MoveTo({0.125, 0.375}).LineTo({5, 5}),
+          .want = SVG_DOC(PATH("m.125.375L5 5"))
+      },
+      TestCase{
+          .name = "Fractions without separators",
+          .path = svg::Path{}.MoveTo({0.5, 0.5}).LineTo({0.75, 1})
+              .LineTo({0.5, 0.5}),
+          .want = SVG_DOC(PATH("m.5.5.25.5L.5.5"))
+      },
+      TestCase{
+          .name = "Exponent notation where shorter",
+          .path = svg::Path{}.MoveTo({100000, 0.5}).LineTo({200000, 0.5001})
+              .LineTo({200000.0001, 0.6}),
+          .want = SVG_DOC(PATH("m1e+05 .5 1e+05 1e-04L200000.0001.6"))
+      },
+      TestCase{
+          .name = "Subpaths",
+          .path = svg::Path{}.MoveTo({1, 1}).LineTo({2, 1}).Close()
+              .MoveTo({5, 5}).LineTo({5, 6}),
+          .want = SVG_DOC(PATH("m1 1h1Zm4 4v1"))
+      },
+      TestCase{
+          .name = "Line first moves",
+          .path = svg::Path{}.Close().LineTo({1, 2}).LineTo({3, 4}),
+          .want = SVG_DOC(PATH("m1 2 2 2"))
+      },
+      TestCase{
+          .name = "Style",
+          .path = svg::Path{}.MoveTo({1, 2}).SetFillColor("red")
+              .SetStrokeLineJoin("round"),
+          .want = SVG_DOC("<path fill=\"red\" stroke=\"none\" "
+                          "stroke-width=\"1\" stroke-linejoin=\"round\" "
+                          "d=\"m1 2\"/>")
+      },
+  };
+
+  for (auto &[name, path, want] : test_cases) {
+    svg::Document doc;
+    doc.Add(path);
+    EXPECT_EQ(Render(doc), want) << name;
+  }
+}
+
+TEST(TestPath, TestAddPolyline) {
+  auto polyline = svg::Polyline{}.AddPoint({1, 1}).AddPoint({2, 2});
+  auto path = svg::Path{}.AddPolyline(polyline).Close()
+      .AddPolyline(polyline);
+
+  using Command = svg::Path::Command;
+  EXPECT_EQ(path.GetCommands(),
+            (std::pmr::vector<Command>{Command::kMoveTo, Command::kLineTo,
+                                       Command::kClose, Command::kMoveTo,
+                                       Command::kLineTo}));
+  EXPECT_EQ(path.GetPoints().size(), 4u);
+}
+
+// The reader follows the relative coordinates the same way as SVG
+// renderers, so the points come back within rounding of the originals.
+TEST(TestPath, TestPolylinesAsPaths) {
+  auto route = Route(1000, 7);
+  svg::Document doc;
+  doc.Add(svg::Polyline{}.AddPoints(route).SetStrokeColor("red"));
+
+  auto polyline_svg = Render(doc);
+  auto path_svg = Render(doc, {.polylines_as_paths = true});
+  EXPECT_LT(path_svg.size() * 10, polyline_svg.size() * 7);
+
+  auto read = svg::ReadDocument(path_svg);
+  ASSERT_EQ(read.Size(), 1u);
+  auto &path = std::get<svg::Path>(read.Get(0));
+  EXPECT_EQ(path.GetStyle(),
+            std::get<svg::Polyline>(doc.Get(0)).GetStyle());
+  ASSERT_EQ(path.GetPoints().size(), route.size());
+  for (size_t i = 0; i < route.size(); ++i) {
+    EXPECT_NEAR(path.GetPoints()[i].x, route[i].x, 1e-9) << i;
+    EXPECT_NEAR(path.GetPoints()[i].y, route[i].y, 1e-9) << i;
+  }
+
+  // Rendering the read path again gives the same data.
+  EXPECT_EQ(Render(read), path_svg);
+}
+
+TEST(TestPath, TestWriterFormat) {
+  auto polyline = svg::Polyline{}.AddPoint({1, 2}).AddPoint({3, 4});
+  std::string out;
+  {
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    writer.SetPolylinesAsPaths(true);
+    polyline.Render(writer);
+  }
+  EXPECT_EQ(out, PATH("m1 2 2 2"));
+
+  // Document renders leave the setting of the writer as it was.
+  out.clear();
+  {
+    svg::StringSink sink(out);
+    svg::Writer writer(sink);
+    svg::Document doc;
+    doc.Add(polyline);
+    doc.Render(writer, {.polylines_as_paths = true});
+    EXPECT_FALSE(writer.GetPolylinesAsPaths());
+  }
+  EXPECT_EQ(out, SVG_DOC(PATH("m1 2 2 2")));
+}
+
+TEST(TestPath, TestStorages) {
+  auto route = Route(100, 11);
+  auto path = svg::Path{}.AddPolyline(svg::Polyline{}.AddPoints(route))
+      .Close().MoveTo({1, 1}).LineTo({1, 5}).SetStrokeWidth(2);
+
+  svg::Document doc;
+  doc.Add(svg::Circle{});
+  doc.Add(path);
+  doc.Add(svg::Path{});
+  doc.Add(svg::Polyline{}.AddPoints(route));
+  svg::CompactDocument compact;
+  for (size_t i = 0; i < doc.Size(); ++i) {
+    compact.Add(doc.Get(i));
+  }
+  std::string bytes;
+  svg::StringSink sink(bytes);
+  svg::SaveSnapshot(doc, sink);
+  auto snapshot = svg::Snapshot::FromBytes(bytes);
+
+  for (auto options : {svg::RenderOptions{},
+                       svg::RenderOptions{.polylines_as_paths = true},
+                       svg::RenderOptions{.polylines_as_paths = true,
+                                          .precision = 1},
+                       svg::RenderOptions{.viewport = svg::Box{{0, 0},
+                                                               {2, 2}}}}) {
+    auto want = Render(doc, options);
+    EXPECT_EQ(Render(compact, options), want);
+    EXPECT_EQ(Render(snapshot, options), want);
+    EXPECT_EQ(Render(snapshot.ToDocument(), options), want);
+  }
+}
+
+TEST(TestPath, TestStats) {
+  svg::Document doc;
+  doc.Add(svg::Path{}.MoveTo({1, 1}).LineTo({2, 2}).Close());
+  doc.Add(svg::Polyline{}.AddPoint({1, 1}).AddPoint({2, 2}));
+
+  svg::RenderStats stats;
+  Render(doc, {.polylines_as_paths = true, .stats = &stats});
+  EXPECT_EQ(stats.paths.count, 1u);
+  EXPECT_EQ(stats.paths.points, 2u);
+  // Polylines stay polylines in the statistics.
+  EXPECT_EQ(stats.polylines.count, 1u);
+  EXPECT_EQ(stats.Total().count, 2u);
+}
+
+TEST(TestPath, TestPrecision) {
+  struct TestCase {
+    std::string name;
+    int precision;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Integers", .precision = 0,
+               .want = SVG_DOC(PATH("m1 2h2v1Z"))},
+      TestCase{.name = "One digit", .precision = 1,
+               .want = SVG_DOC(PATH("m1.2 2.5h1.4l.2.7Z"))},
+      TestCase{.name = "Four digits", .precision = 4,
+               .want = SVG_DOC(PATH("m1.234 2.46L2.6 2.5l.21.66Z"))},
+  };
+
+  svg::Document doc;
+  doc.Add(svg::Path{}.MoveTo({1.234, 2.46}).LineTo({2.6, 2.5})
+              .LineTo({2.81, 3.16}).Close());
+  for (auto &[name, precision, want] : test_cases) {
+    EXPECT_EQ(Render(doc, {.precision = precision}), want) << name;
+  }
+
+  // Rounded routes read back within half a unit of the last digit.
+  auto route = Route(1000, 13);
+  doc = svg::Document{};
+  doc.Add(svg::Polyline{}.AddPoints(route));
+  auto read = svg::ReadDocument(
+      Render(doc, {.polylines_as_paths = true, .precision = 1}));
+  auto &path = std::get<svg::Path>(read.Get(0));
+  ASSERT_EQ(path.GetPoints().size(), route.size());
+  for (size_t i = 0; i < route.size(); ++i) {
+    EXPECT_NEAR(path.GetPoints()[i].x, route[i].x, 0.05 + 1e-9) << i;
+    EXPECT_NEAR(path.GetPoints()[i].y, route[i].y, 0.05 + 1e-9) << i;
+  }
+}
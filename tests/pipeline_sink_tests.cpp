@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/pipeline_sink.h"
+#include "svg/writer.h"
+
+namespace {
+// Holds every write until Open.
+class GateSink final : public svg::Sink {
+ public:
+  void Write(std::string_view data) override {
+    std::unique_lock lock(mutex_);
+    opened_.wait(lock, [this] {
+      return open_;
+    });
+    out_.append(data);
+  }
+  void Open() {
+    std::lock_guard lock(mutex_);
+    open_ = true;
+    opened_.notify_all();
+  }
+  const std::string &Out() const {
+    return out_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable opened_;
+  bool open_ = false;
+  std::string out_;
+};
+
+class SinkError final : public std::runtime_error {
+ public:
+  SinkError() : std::runtime_error("disk full") {}
+};
+}
+
+TEST(TestPipelineSink, TestRoundTrip) {
+  struct TestCase {
+    std::string name;
+    size_t depth;
+    size_t chunk_size;
+    size_t writer_capacity;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Default", .depth = 4, .chunk_size = 64 * 1024,
+               .writer_capacity = svg::Writer::kDefaultCapacity},
+      TestCase{.name = "Chunks smaller than blocks", .depth = 2,
+               .chunk_size = 1000, .writer_capacity = 4096},
+      TestCase{.name = "Chunks larger than blocks", .depth = 3,
+               .chunk_size = 10000, .writer_capacity = 1024},
+      TestCase{.name = "Single tiny chunk", .depth = 1, .chunk_size = 7,
+               .writer_capacity = 64},
+  };
+
+  auto doc = svg_test::SceneDocument(2000);
+  std::string want;
+  {
+    svg::StringSink sink(want);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+  }
+
+  for (auto &[name, depth, chunk_size, writer_capacity] : test_cases) {
+    std::string got;
+    size_t max_block = 0;
+    svg::CallbackSink sink([&](std::string_view data) {
+      got.append(data);
+      max_block = std::max(max_block, data.size());
+    });
+    svg::PipelineSink pipeline(sink, depth, chunk_size);
+    svg::Writer writer(pipeline, writer_capacity);
+    doc.Render(writer);
+    writer.Flush();
+    pipeline.Finish();
+
+    EXPECT_EQ(got, want) << name;
+    EXPECT_LE(max_block, chunk_size) << name;
+  }
+}
+
+TEST(TestPipelineSink, TestBackpressure) {
+  constexpr size_t kDepth = 3;
+  constexpr size_t kChunkSize = 100;
+  constexpr size_t kChunks = 50;
+
+  GateSink sink;
+  svg::PipelineSink pipeline(sink, kDepth, kChunkSize);
+  std::atomic<size_t> written = 0;
+  std::thread producer([&] {
+    for (size_t i = 0; i < kChunks; ++i) {
+      pipeline.Write(std::string(kChunkSize, static_cast<char>('a' + i % 26)));
+      written += kChunkSize;
+    }
+  });
+
+  // The producer stops once the queue is full, whatever the timing.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LE(written.load(), (kDepth + 2) * kChunkSize);
+  sink.Open();
+  producer.join();
+  pipeline.Finish();
+
+  EXPECT_EQ(written.load(), kChunks * kChunkSize);
+  ASSERT_EQ(sink.Out().size(), kChunks * kChunkSize);
+  for (size_t i = 0; i < kChunks; ++i) {
+    EXPECT_EQ(sink.Out()[i * kChunkSize], static_cast<char>('a' + i % 26));
+  }
+}
+
+TEST(TestPipelineSink, TestSinkError) {
+  auto doc = svg_test::SceneDocument(2000);
+  size_t writes = 0;
+  svg::CallbackSink sink([&](std::string_view) {
+    if (++writes == 2) {
+      throw SinkError();
+    }
+  });
+  svg::PipelineSink pipeline(sink, 2, 1000);
+  auto render = [&] {
+    svg::Writer writer(pipeline, 1024);
+    doc.Render(writer);
+    writer.Flush();
+    pipeline.Finish();
+  };
+
+  EXPECT_THROW(render(), SinkError);
+  EXPECT_EQ(writes, 2u) << "Nothing is written after the error";
+  EXPECT_THROW(pipeline.Finish(), SinkError);
+}
+
+TEST(TestPipelineSink, TestCancel) {
+  auto doc = svg_test::SceneDocument(2000);
+  GateSink sink;
+  svg::PipelineSink pipeline(sink, 2, 1000);
+  bool cancelled = false;
+  std::thread producer([&] {
+    try {
+      svg::Writer writer(pipeline, 1024);
+      doc.Render(writer);
+      writer.Flush();
+    } catch (const svg::PipelineCancelled &) {
+      cancelled = true;
+    }
+  });
+
+  pipeline.Cancel();
+  sink.Open();
+  producer.join();
+
+  EXPECT_TRUE(cancelled);
+  EXPECT_THROW(pipeline.Finish(), svg::PipelineCancelled);
+  EXPECT_LE(sink.Out().size(), 1000u) << "At most the chunk being written";
+}
+
+TEST(TestPipelineSink, TestInvalidArguments) {
+  std::string out;
+  svg::StringSink sink(out);
+  EXPECT_THROW(svg::PipelineSink(sink, 0), std::invalid_argument);
+  EXPECT_THROW(svg::PipelineSink(sink, 1, 0), std::invalid_argument);
+}
+
+TEST(TestPipelineSink, TestWriteAfterFinish) {
+  std::string out;
+  svg::StringSink sink(out);
+  svg::PipelineSink pipeline(sink, 1, 4);
+  pipeline.Write("<svg>");
+  pipeline.Finish();
+
+  EXPECT_THROW(pipeline.Write("</svg>"), std::logic_error);
+  EXPECT_EQ("<svg>", out);
+}
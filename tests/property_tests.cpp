@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/common.h"
+#include "svg/property.h"
+
+TEST(TestProperty, TestIntern) {
+  struct TestCase {
+    std::string name;
+    svg::Color color;
+    std::string_view want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "None", .color = svg::Color{}, .want = ""},
+      TestCase{.name = "String", .color = "red", .want = "red"},
+      TestCase{.name = "Rgb", .color = svg::Rgb{1, 20, 255},
+               .want = "rgb(1,20,255)"},
+      TestCase{.name = "Rgba", .color = svg::Rgba{1, 2, 3, 0.5},
+               .want = "rgba(1,2,3,0.5)"},
+  };
+
+  for (auto &[name, color, want] : test_cases) {
+    auto got = svg::Property::Intern(color);
+
+    EXPECT_EQ(want, got.View()) << name;
+    EXPECT_EQ(!want.empty(), got.HasValue()) << name;
+    EXPECT_TRUE(got == svg::Property::Intern(color)) << name;
+  }
+
+  EXPECT_TRUE(svg::Property::Intern("rgb(1,20,255)") ==
+      svg::Property::Intern(svg::Rgb{1, 20, 255}));
+  EXPECT_TRUE(svg::Property::Intern("round") !=
+      svg::Property::Intern("square"));
+  EXPECT_FALSE(svg::Property{}.HasValue());
+}
+
+TEST(TestProperty, TestPoolLimit) {
+  auto before = svg::Property::Usage();
+  auto kept = svg::Property::Intern("pool-limit-kept");
+  auto after = svg::Property::Usage();
+  EXPECT_EQ(before.entries + 1, after.entries);
+  EXPECT_EQ(before.bytes + 15, after.bytes);
+
+  svg::Property::SetPoolLimit(after.bytes);
+  EXPECT_THROW(svg::Property::Intern("pool-limit-new"), std::length_error);
+  EXPECT_TRUE(kept == svg::Property::Intern("pool-limit-kept"))
+      << "Interned values are still found";
+  EXPECT_EQ(after.bytes, svg::Property::Usage().bytes);
+  svg::Property::SetPoolLimit(SIZE_MAX);
+
+  EXPECT_EQ("pool-limit-new", svg::Property::Intern("pool-limit-new").View());
+}
+
+TEST(TestProperty, TestClearPool) {
+  svg::Property::Intern("pool-clear");
+  EXPECT_GT(svg::Property::Usage().entries, 0u);
+
+  svg::Property::ClearPool();
+  EXPECT_EQ(0u, svg::Property::Usage().entries);
+  EXPECT_EQ(0u, svg::Property::Usage().bytes);
+
+  EXPECT_EQ("pool-clear", svg::Property::Intern("pool-clear").View());
+  EXPECT_EQ(1u, svg::Property::Usage().entries);
+}
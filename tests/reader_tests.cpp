@@ -0,0 +1,149 @@
+#include <unistd.h>
+
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/reader.h"
+#include "svg/render_options.h"
+#include "svg/simplify.h"
+
+namespace {
+template<typename DocumentType>
+std::string Render(const DocumentType &doc,
+                   const svg::RenderOptions &options = {}) {
+  std::ostringstream ss;
+  doc.Render(ss, options);
+  return ss.str();
+}
+
+std::string Render(const svg::Section &section) {
+  svg::Document doc;
+  doc.Add(section);
+  return Render(doc);
+}
+}
+
+TEST(TestReader, TestRoundTrip) {
+  struct TestCase {
+    std::string name;
+    svg::RenderOptions options;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Default"},
+      TestCase{.name = "Styles", .options = {.deduplicate_styles = true}},
+  };
+
+  auto doc = svg_test::FeatureScene();
+  for (auto &[name, options] : test_cases) {
+    auto svg = Render(doc, options);
+    auto read = svg::ReadDocument(svg);
+    EXPECT_EQ(Render(read), Render(doc)) << name;
+    EXPECT_EQ(Render(svg::ReadSection(svg)), Render(doc)) << name;
+  }
+}
+
+TEST(TestReader, TestReadObjects) {
+  auto read = svg::ReadDocument(Render(svg_test::FeatureScene()));
+
+  // The section is read back as its objects.
+  ASSERT_EQ(read.Size(), 10u);
+  auto &text = std::get<svg::Text>(read.Get(4));
+  EXPECT_EQ(text.GetData(), "Fish & <Chips>");
+  EXPECT_EQ(text.GetFontFamily(), svg::Property::Intern("Tom & Jerry"));
+  EXPECT_EQ(text.GetFontSize(), 12u);
+  auto &rectangle = std::get<svg::Rectangle>(read.Get(6));
+  EXPECT_EQ(rectangle.GetHeight(), 2.5);
+  auto &circle = std::get<svg::Circle>(read.Get(9));
+  EXPECT_EQ(circle.GetCenter().x, -50);
+  EXPECT_EQ(circle.GetCenter().y, 1e-3);
+}
+
+TEST(TestReader, TestOrigin) {
+  // Sections are moved by a group transform, read back into positions.
+  auto svg = Render(svg_test::FeatureScene(), {.origin = svg::Point{-20, 30}});
+  ASSERT_NE(svg.find("<g transform="), std::string::npos);
+  auto shifted = svg::ReadDocument(svg);
+  ASSERT_EQ(shifted.Size(), 10u);
+  EXPECT_EQ(std::get<svg::Circle>(shifted.Get(0)).GetCenter().x, 21);
+  EXPECT_EQ(std::get<svg::Circle>(shifted.Get(0)).GetCenter().y, -28);
+  EXPECT_EQ(std::get<svg::Circle>(shifted.Get(7)).GetCenter().x, 120);
+  EXPECT_EQ(std::get<svg::Circle>(shifted.Get(7)).GetCenter().y, 70);
+
+  auto read = svg::ReadDocument(
+      "<svg><g transform=\"translate(10, 20)\">"
+      "<g transform=\"translate(1)\"><circle cx=\"1\" cy=\"2\"/></g>"
+      "<rect x=\"3\" y=\"4\"/></g><circle cx=\"5\" cy=\"6\"/></svg>");
+  ASSERT_EQ(read.Size(), 3u);
+  EXPECT_EQ(std::get<svg::Circle>(read.Get(0)).GetCenter().x, 12);
+  EXPECT_EQ(std::get<svg::Circle>(read.Get(0)).GetCenter().y, 22);
+  EXPECT_EQ(std::get<svg::Rectangle>(read.Get(1)).GetPoint().x, 13);
+  EXPECT_EQ(std::get<svg::Rectangle>(read.Get(1)).GetPoint().y, 24);
+  EXPECT_EQ(std::get<svg::Circle>(read.Get(2)).GetCenter().x, 5);
+}
+
+TEST(TestReader, TestWhitespace) {
+  auto read = svg::ReadDocument(
+      "<svg xmlns=\"http://www.w3.org/2000/svg\">\n"
+      "  <circle cx = \"1\"  cy=\"2\" r=\"3\" fill=\"none\" />\n"
+      "  <polyline points=\" 1,2  3,4 \"/>\n"
+      "</svg>\n");
+
+  ASSERT_EQ(read.Size(), 2u);
+  EXPECT_EQ(std::get<svg::Circle>(read.Get(0)).GetRadius(), 3);
+  EXPECT_EQ(std::get<svg::Polyline>(read.Get(1)).GetPoints().size(), 2u);
+}
+
+TEST(TestReader, TestErrors) {
+  struct TestCase {
+    std::string name;
+    std::string svg;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Empty", .svg = ""},
+      TestCase{.name = "Unclosed", .svg = "<svg><circle r=\"1\"/>"},
+      TestCase{.name = "Element", .svg = "<svg><ellipse rx=\"1\"/></svg>"},
+      TestCase{.name = "Number", .svg = "<svg><circle r=\"1x\"/></svg>"},
+      TestCase{.name = "Points",
+               .svg = "<svg><polyline points=\"1 2\"/></svg>"},
+      TestCase{.name = "Attribute", .svg = "<svg><circle r=\"1/></svg>"},
+      TestCase{.name = "Class", .svg = "<svg><circle class=\"s0\"/></svg>"},
+      TestCase{.name = "Class id",
+               .svg = "<svg><style>.s4000000000{fill:red}</style></svg>"},
+      TestCase{.name = "Text", .svg = "<svg><text>abc</svg>"},
+      TestCase{.name = "Trailing", .svg = "<svg></svg><svg></svg>"},
+      TestCase{.name = "Transform",
+               .svg = "<svg><g transform=\"scale(2)\"></g></svg>"},
+      TestCase{.name = "Unclosed group", .svg = "<svg><g></svg>"},
+      TestCase{.name = "Group end", .svg = "<svg></g></svg>"},
+  };
+
+  for (auto &[name, svg] : test_cases) {
+    EXPECT_THROW(svg::ReadDocument(svg), std::runtime_error) << name;
+  }
+}
+
+TEST(TestReader, TestReadFile) {
+  std::string path = "/tmp/svg_reader_XXXXXX";
+  int fd = mkstemp(path.data());
+  auto svg = Render(svg_test::FeatureScene());
+  ASSERT_EQ(write(fd, svg.data(), svg.size()),
+            static_cast<ssize_t>(svg.size()));
+
+  EXPECT_EQ(Render(svg::ReadDocumentFile(path)), svg);
+  EXPECT_EQ(Render(svg::ReadSectionFile(path)), svg);
+  close(fd);
+  unlink(path.c_str());
+
+  EXPECT_THROW(svg::ReadDocumentFile(path), std::system_error);
+}
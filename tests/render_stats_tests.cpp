@@ -0,0 +1,133 @@
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "svg/compact_document.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/simplify.h"
+
+namespace {
+template<typename FigureType>
+uint64_t Size(const FigureType &figure) {
+  std::ostringstream ss;
+  figure.Render(ss);
+  return ss.str().size();
+}
+
+void ExpectEqual(const svg::FigureStats &want, const svg::FigureStats &got,
+                 const std::string &name) {
+  EXPECT_EQ(want.count, got.count) << name;
+  EXPECT_EQ(want.bytes, got.bytes) << name;
+  EXPECT_EQ(want.points, got.points) << name;
+}
+
+void ExpectEqual(const svg::RenderStats &want, const svg::RenderStats &got) {
+  ExpectEqual(want.circles, got.circles, "circles");
+  ExpectEqual(want.polylines, got.polylines, "polylines");
+  ExpectEqual(want.texts, got.texts, "texts");
+  ExpectEqual(want.rectangles, got.rectangles, "rectangles");
+  ExpectEqual(want.sections, got.sections, "sections");
+}
+}
+
+TEST(TestRenderStats, TestDocument) {
+  auto circle = svg::Circle{}.SetCenter({1, 2});
+  auto polyline = svg::Polyline{}.AddPoint({0, 0}).AddPoint({1, 0.001})
+      .AddPoint({2, 0});
+  auto text = svg::Text{}.SetData("label");
+  auto rectangle = svg::Rectangle{}.SetWidth(3);
+  auto section = svg::SectionBuilder{}.Add(circle).Build();
+
+  svg::Document doc;
+  doc.Add(circle);
+  doc.Add(circle);
+  doc.Add(polyline);
+  doc.Add(text);
+  doc.Add(rectangle);
+  doc.Add(section);
+
+  svg::RenderStats want;
+  want.circles = {.count = 2, .bytes = 2 * Size(circle), .points = 2};
+  want.polylines = {.count = 1, .bytes = Size(polyline), .points = 3};
+  want.texts = {.count = 1, .bytes = Size(text), .points = 1};
+  want.rectangles = {.count = 1, .bytes = Size(rectangle), .points = 1};
+  want.sections = {.count = 1, .bytes = Size(section), .points = 0};
+
+  svg::RenderStats stats;
+  std::ostringstream out;
+  doc.Render(out, svg::RenderOptions{.stats = &stats});
+  ExpectEqual(want, stats);
+  EXPECT_LT(stats.Total().bytes, out.str().size());
+
+  svg::RenderStats compact_stats;
+  svg::CompactDocument compact;
+  for (auto object : {svg::Object(circle), svg::Object(circle),
+                      svg::Object(polyline), svg::Object(text),
+                      svg::Object(rectangle), svg::Object(section)}) {
+    compact.Add(object);
+  }
+  std::ostringstream compact_out;
+  compact.Render(compact_out, svg::RenderOptions{.stats = &compact_stats});
+  ExpectEqual(want, compact_stats);
+
+  svg::RenderStats simplified;
+  doc.Render(out, svg::RenderOptions{
+      .simplification = svg::Simplification{
+          svg::SimplifyAlgorithm::kDouglasPeucker, 0.1},
+      .stats = &simplified});
+  EXPECT_EQ(2u, simplified.polylines.points) << "Points after simplification";
+}
+
+TEST(TestRenderStats, TestParallelAndAccumulated) {
+  svg::Document doc;
+  for (int i = 0; i < 3000; ++i) {
+    doc.Add(svg::Circle{}.SetCenter({1.0 * i, 2}));
+  }
+
+  svg::RenderStats serial;
+  std::ostringstream out;
+  doc.Render(out, svg::RenderOptions{.stats = &serial});
+  svg::RenderStats parallel;
+  doc.Render(out, svg::RenderOptions{.threads = 4, .stats = &parallel});
+  ExpectEqual(serial, parallel);
+
+  doc.Render(out, svg::RenderOptions{.stats = &serial});
+  EXPECT_EQ(6000u, serial.circles.count) << "Stats are added up";
+}
+
+TEST(TestRenderStats, TestSectionBuilder) {
+  auto inner = svg::SectionBuilder{}.Add(svg::Circle{}).Build();
+
+  svg::RenderStats stats;
+  auto section = svg::SectionBuilder{}
+      .Add(svg::Polyline{}.AddPoint({1, 2}).AddPoint({3, 4}))
+      .Add(inner)
+      .Build(&stats);
+
+  svg::RenderStats want;
+  want.polylines = {.count = 1,
+                    .bytes = Size(svg::Polyline{}.AddPoint({1, 2})
+                                      .AddPoint({3, 4})),
+                    .points = 2};
+  want.sections = {.count = 1, .bytes = Size(inner), .points = 0};
+  ExpectEqual(want, stats);
+  EXPECT_EQ(Size(section), stats.Total().bytes);
+
+  // Pieces of 4 KB and more are shared instead of copied.
+  svg::SectionBuilder big_builder;
+  for (int i = 0; i < 200; ++i) {
+    big_builder.Add(svg::Circle{}.SetCenter({1.0 * i, 2.0 * i}));
+  }
+  auto big = big_builder.Build();
+  svg::RenderStats shared_stats;
+  auto shared = svg::SectionBuilder{}
+      .Add(svg::Circle{})
+      .Add(big)
+      .Build(&shared_stats);
+  EXPECT_EQ(Size(big), shared_stats.sections.bytes);
+  EXPECT_EQ(Size(shared), shared_stats.Total().bytes);
+}
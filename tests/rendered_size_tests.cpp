@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/common.h"
+#include "svg/compact_document.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/snapshot.h"
+#include "svg/writer.h"
+
+namespace {
+template<typename FigureType>
+std::string Render(const FigureType &figure, const svg::Writer *format) {
+  std::string out;
+  svg::StringSink sink(out);
+  svg::Writer writer(sink);
+  if (format) {
+    writer.CopyFormat(*format);
+  }
+  figure.Render(writer);
+  writer.Flush();
+  return out;
+}
+}
+
+TEST(TestRenderedSize, TestFigures) {
+  auto rounded = svg::Writer::Measuring();
+  rounded.SetPrecision(1);
+  rounded.SetPolylinesAsPaths(true);
+
+  auto circle = svg::Circle{}.SetCenter({0.1 + 0.2, 5}).SetRadius(2);
+  auto polyline = svg::Polyline{}.AddPoint({1.25, 2.5}).AddPoint({3, 4.125});
+  auto text = svg::Text{}.SetData("<&>").SetFontFamily("Verdana");
+  auto rectangle = svg::Rectangle{}.SetWidth(1e-7).SetHeight(123456);
+  auto path = svg::Path{}.MoveTo({1, 1}).LineTo({2.55, 1}).Close();
+  auto section = svg::SectionBuilder{}.Add(polyline).Build();
+
+  EXPECT_EQ(circle.RenderedSize(), Render(circle, nullptr).size());
+  EXPECT_EQ(polyline.RenderedSize(), Render(polyline, nullptr).size());
+  EXPECT_EQ(text.RenderedSize(), Render(text, nullptr).size());
+  EXPECT_EQ(rectangle.RenderedSize(), Render(rectangle, nullptr).size());
+  EXPECT_EQ(path.RenderedSize(), Render(path, nullptr).size());
+  EXPECT_EQ(section.RenderedSize(), Render(section, nullptr).size());
+
+  // The format of the target writer changes the size.
+  EXPECT_EQ(circle.RenderedSize(rounded), Render(circle, &rounded).size());
+  EXPECT_EQ(polyline.RenderedSize(rounded),
+            Render(polyline, &rounded).size());
+  EXPECT_EQ(rectangle.RenderedSize(rounded),
+            Render(rectangle, &rounded).size());
+  EXPECT_EQ(path.RenderedSize(rounded), Render(path, &rounded).size());
+  EXPECT_LT(circle.RenderedSize(rounded), circle.RenderedSize());
+}
+
+TEST(TestRenderedSize, TestDocuments) {
+  struct TestCase {
+    std::string name;
+    svg::RenderOptions options;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Default", .options = {}},
+      TestCase{.name = "Viewport",
+               .options = {.viewport = svg::Box{{0, 0}, {100, 100}}}},
+      TestCase{.name = "Simplification",
+               .options = {.simplification = svg::Simplification{
+                   .tolerance = 2}}},
+      TestCase{.name = "Deduplicate styles",
+               .options = {.deduplicate_styles = true}},
+      TestCase{.name = "Paths and precision",
+               .options = {.polylines_as_paths = true, .precision = 2}},
+      TestCase{.name = "Integer precision and origin",
+               .options = {.precision = 0, .origin = {-1000.5, 3}}},
+      TestCase{.name = "Threads", .options = {.threads = 4}},
+  };
+
+  // The features add a section and values close to zero.
+  auto doc = svg_test::SceneDocument(2000);
+  auto features = svg_test::FeatureScene();
+  for (size_t i = 0; i < features.Size(); ++i) {
+    doc.Add(features.Get(i));
+  }
+  svg::CompactDocument compact;
+  for (size_t i = 0; i < doc.Size(); ++i) {
+    compact.Add(doc.Get(i));
+  }
+  std::string bytes;
+  svg::StringSink sink(bytes);
+  svg::SaveSnapshot(doc, sink);
+  auto snapshot = svg::Snapshot::FromBytes(bytes);
+
+  for (auto &[name, options] : test_cases) {
+    std::ostringstream ss;
+    doc.Render(ss, options);
+    uint64_t want = ss.str().size();
+    EXPECT_EQ(doc.RenderedSize(options), want) << name;
+    EXPECT_EQ(compact.RenderedSize(options), want) << name;
+    EXPECT_EQ(snapshot.RenderedSize(options), want) << name;
+  }
+  EXPECT_EQ(svg::Document{}.RenderedSize(), Render(svg::Document{}, nullptr)
+      .size());
+}
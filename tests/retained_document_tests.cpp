@@ -0,0 +1,133 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/retained_document.h"
+
+namespace {
+std::string Render(const svg::Document &doc) {
+  std::ostringstream ss;
+  doc.Render(ss);
+  return ss.str();
+}
+
+std::string Render(svg::RetainedDocument &doc) {
+  std::ostringstream ss;
+  doc.Render(ss);
+  return ss.str();
+}
+
+std::string Render(const svg::Document &doc,
+                   const svg::RenderOptions &options) {
+  std::ostringstream ss;
+  doc.Render(ss, options);
+  return ss.str();
+}
+
+std::string Render(svg::RetainedDocument &doc,
+                   const svg::RenderOptions &options) {
+  std::ostringstream ss;
+  doc.Render(ss, options);
+  return ss.str();
+}
+}
+
+TEST(TestRetainedDocument, TestRender) {
+  svg::RetainedDocument retained;
+  auto circle = retained.Add(svg::Circle{}.SetCenter({1, 2}));
+  auto text = retained.Add(svg::Text{}.SetData("a"));
+  auto polyline = retained.Add(svg::Polyline{}.AddPoint({3, 4}));
+  EXPECT_EQ(3u, retained.DirtyCount());
+
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({1, 2}));
+  doc.Add(svg::Text{}.SetData("a"));
+  doc.Add(svg::Polyline{}.AddPoint({3, 4}));
+  EXPECT_EQ(Render(doc), Render(retained));
+  EXPECT_EQ(0u, retained.DirtyCount());
+  EXPECT_EQ(Render(doc), Render(retained)) << "Rendered from cache";
+
+  retained.Modify<svg::Circle>(circle, [](svg::Circle &figure) {
+    figure.SetRadius(5);
+  });
+  retained.Modify(circle, [](svg::Object &object) {
+    std::get<svg::Circle>(object).SetFillColor("red");
+  });
+  EXPECT_EQ(1u, retained.DirtyCount()) << "Modified objects are counted once";
+  retained.Modify<svg::Polyline>(polyline, [](svg::Polyline &figure) {
+    figure.AddPoint({5, 6});
+  });
+  retained.Remove(text);
+  EXPECT_EQ(2u, retained.DirtyCount());
+
+  svg::Document modified;
+  modified.Add(svg::Circle{}.SetCenter({1, 2}).SetRadius(5)
+                   .SetFillColor("red"));
+  modified.Add(svg::Polyline{}.AddPoint({3, 4}).AddPoint({5, 6}));
+  EXPECT_EQ(Render(modified), Render(retained));
+
+  auto added = retained.Add(svg::Rectangle{}.SetWidth(2));
+  modified.Add(svg::Rectangle{}.SetWidth(2));
+  EXPECT_EQ(1u, retained.DirtyCount());
+  EXPECT_EQ(Render(modified), Render(retained));
+  EXPECT_EQ(3u, added);
+}
+
+TEST(TestRetainedDocument, TestRemoveDirty) {
+  svg::RetainedDocument retained;
+  auto id = retained.Add(svg::Circle{});
+  retained.Remove(id);
+  EXPECT_EQ(0u, retained.DirtyCount());
+  EXPECT_EQ(Render(svg::Document{}), Render(retained));
+}
+
+TEST(TestRetainedDocument, TestRenderOptions) {
+  svg::RetainedDocument retained;
+  svg::Document doc;
+  std::vector<svg::Object> objects{
+      svg::Circle{}.SetCenter({1.25, 2}),
+      svg::Polyline{}.AddPoint({3, 4}).AddPoint({3.5, 4}).AddPoint({30, 40}),
+      svg::Rectangle{}.SetPoint({100, 100}).SetWidth(2),
+  };
+  for (auto &object : objects) {
+    retained.Add(object);
+    doc.Add(object);
+  }
+
+  std::vector<svg::RenderOptions> options_list{
+      {.precision = 0},
+      {.polylines_as_paths = true, .origin = {1, 1}},
+      {.simplification = svg::Simplification{.tolerance = 1}},
+      {.viewport = svg::Box{{0, 0}, {10, 10}}, .precision = 0},
+      {},
+  };
+  for (auto &options : options_list) {
+    EXPECT_EQ(Render(doc, options), Render(retained, options));
+    EXPECT_EQ(0u, retained.DirtyCount());
+    EXPECT_EQ(Render(doc, options), Render(retained, options))
+        << "Rendered from cache";
+  }
+
+  svg::RenderStats stats;
+  Render(retained, {.stats = &stats});
+  EXPECT_EQ(0u, stats.Of<svg::Circle>().count) << "Nothing was formatted";
+  retained.Modify<svg::Circle>(0, [](svg::Circle &figure) {
+    figure.SetRadius(2);
+  });
+  Render(retained, {.stats = &stats});
+  EXPECT_EQ(1u, stats.Of<svg::Circle>().count);
+
+  EXPECT_THROW(Render(retained, {.deduplicate_styles = true}),
+               std::invalid_argument);
+  EXPECT_THROW(Render(retained, {.threads = 2}), std::invalid_argument);
+  EXPECT_THROW(Render(retained, {.precision = -1}), std::invalid_argument);
+  EXPECT_EQ(0u, retained.DirtyCount()) << "Rejected options keep the cache";
+}
@@ -0,0 +1,145 @@
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/simplify.h"
+
+TEST(TestSimplify, TestSimplify) {
+  struct TestCase {
+    std::string name;
+    std::vector<svg::Point> points;
+    svg::Simplification simplification;
+    std::vector<size_t> want;
+  };
+
+  std::vector<svg::Point> zigzag{{0, 0}, {1, 0.1}, {2, -0.1}, {3, 5},
+                                 {4, 0}, {5, 0.05}, {6, 0}};
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Zero tolerance",
+          .points = zigzag,
+          .simplification = {},
+          .want = {0, 1, 2, 3, 4, 5, 6}
+      },
+      TestCase{
+          .name = "Two points",
+          .points = {{0, 0}, {1, 1}},
+          .simplification = {.tolerance = 100},
+          .want = {0, 1}
+      },
+      TestCase{
+          .name = "Douglas-Peucker",
+          .points = zigzag,
+          .simplification = {
+              .algorithm = svg::SimplifyAlgorithm::kDouglasPeucker,
+              .tolerance = 0.5},
+          .want = {0, 2, 3, 4, 6}
+      },
+      TestCase{
+          .name = "Douglas-Peucker(large tolerance)",
+          .points = zigzag,
+          .simplification = {
+              .algorithm = svg::SimplifyAlgorithm::kDouglasPeucker,
+              .tolerance = 10},
+          .want = {0, 6}
+      },
+      TestCase{
+          .name = "Douglas-Peucker(detour)",
+          .points = {{0, 0}, {10, 0}, {5, 0}},
+          .simplification = {
+              .algorithm = svg::SimplifyAlgorithm::kDouglasPeucker,
+              .tolerance = 1},
+          .want = {0, 1, 2}
+      },
+      TestCase{
+          .name = "Douglas-Peucker(detour before start)",
+          .points = {{0, 0}, {-3, 0.1}, {5, 0}, {10, 0}},
+          .simplification = {
+              .algorithm = svg::SimplifyAlgorithm::kDouglasPeucker,
+              .tolerance = 1},
+          .want = {0, 1, 3}
+      },
+      TestCase{
+          .name = "Visvalingam",
+          .points = zigzag,
+          .simplification = {
+              .algorithm = svg::SimplifyAlgorithm::kVisvalingam,
+              .tolerance = 0.5},
+          .want = {0, 2, 3, 4, 6}
+      },
+      TestCase{
+          .name = "Visvalingam(large tolerance)",
+          .points = zigzag,
+          .simplification = {
+              .algorithm = svg::SimplifyAlgorithm::kVisvalingam,
+              .tolerance = 10},
+          .want = {0, 6}
+      },
+  };
+
+  for (auto &[name, points, simplification, want] : test_cases) {
+    std::vector<size_t> got;
+    svg::Simplify(points.data(), points.size(), simplification, got);
+
+    EXPECT_EQ(want, got) << name;
+  }
+}
+
+TEST(TestSimplify, TestRender) {
+  struct TestCase {
+    std::string name;
+    svg::Polyline polyline;
+    svg::RenderOptions options;
+    std::string want;
+  };
+
+  auto polyline = svg::Polyline{}
+      .AddPoint({0, 0}).AddPoint({1, 0.1}).AddPoint({2, 0}).AddPoint({3, 3});
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "No simplification",
+          .polyline = polyline,
+          .want = "points=\"0,0 1,0.1 2,0 3,3\""
+      },
+      TestCase{
+          .name = "Polyline setting",
+          .polyline = svg::Polyline{polyline}
+              .SetSimplification({.tolerance = 1}),
+          .want = "points=\"0,0 2,0 3,3\""
+      },
+      TestCase{
+          .name = "Document setting",
+          .polyline = polyline,
+          .options = {.simplification = svg::Simplification{.tolerance = 1}},
+          .want = "points=\"0,0 2,0 3,3\""
+      },
+      TestCase{
+          .name = "Polyline overrides document",
+          .polyline = svg::Polyline{polyline}
+              .SetSimplification({.tolerance = 0}),
+          .options = {.simplification = svg::Simplification{.tolerance = 1}},
+          .want = "points=\"0,0 1,0.1 2,0 3,3\""
+      },
+  };
+
+  for (auto &[name, polyline, options, want] : test_cases) {
+    svg::Document doc;
+    doc.Add(std::move(polyline));
+
+    std::ostringstream ss;
+    doc.Render(ss, options);
+    auto got = ss.str();
+
+    EXPECT_NE(std::string::npos, got.find(want)) << name << ": " << got;
+  }
+}
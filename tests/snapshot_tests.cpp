@@ -0,0 +1,146 @@
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/simplify.h"
+#include "svg/snapshot.h"
+#include "svg/writer.h"
+
+namespace {
+std::string Save(const svg::Document &doc) {
+  std::string bytes;
+  svg::StringSink sink(bytes);
+  svg::SaveSnapshot(doc, sink);
+  return bytes;
+}
+
+template<typename DocumentType>
+std::string Render(const DocumentType &doc,
+                   const svg::RenderOptions &options = {}) {
+  std::ostringstream ss;
+  doc.Render(ss, options);
+  return ss.str();
+}
+
+// Deletes the file on scope exit.
+struct TempFile {
+  std::string path = "/tmp/svg_snapshot_XXXXXX";
+  int fd;
+
+  TempFile() : fd(mkstemp(path.data())) {}
+  ~TempFile() {
+    close(fd);
+    unlink(path.c_str());
+  }
+};
+}
+
+TEST(TestSnapshot, TestRender) {
+  struct TestCase {
+    std::string name;
+    svg::RenderOptions options;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Default"},
+      TestCase{.name = "Viewport",
+               .options = {.viewport = svg::Box{{0, 0}, {20, 20}}}},
+      TestCase{.name = "Simplification",
+               .options = {.simplification = svg::Simplification{
+                   svg::SimplifyAlgorithm::kDouglasPeucker, 0.1}}},
+      TestCase{.name = "Deduplicated styles",
+               .options = {.deduplicate_styles = true}},
+  };
+
+  auto doc = svg_test::FeatureScene();
+  auto snapshot = svg::Snapshot::FromBytes(Save(doc));
+  EXPECT_EQ(doc.Size(), snapshot.Size());
+  for (auto &[name, options] : test_cases) {
+    EXPECT_EQ(Render(doc, options), Render(snapshot, options)) << name;
+    EXPECT_EQ(Render(doc, options), Render(snapshot.ToDocument(), options))
+              << name;
+  }
+}
+
+TEST(TestSnapshot, TestSection) {
+  auto doc = svg_test::FeatureScene();
+  svg::SectionBuilder builder;
+  for (size_t i = 0; i < doc.Size(); ++i) {
+    builder.Add(doc.Get(i));
+  }
+  auto section = builder.Build();
+
+  std::string bytes;
+  svg::StringSink sink(bytes);
+  svg::SaveSnapshot(section, sink);
+  auto loaded = svg::Snapshot::FromBytes(bytes).ToSection();
+
+  std::ostringstream want, got;
+  section.Render(want);
+  loaded.Render(got);
+  EXPECT_EQ(want.str(), got.str());
+  EXPECT_EQ(section.Bounds().min.x, loaded.Bounds().min.x);
+  EXPECT_EQ(section.Bounds().max.y, loaded.Bounds().max.y);
+
+  std::ostringstream whole;
+  svg::Snapshot::FromBytes(Save(doc)).ToSection().Render(whole);
+  EXPECT_EQ(want.str(), whole.str());
+}
+
+TEST(TestSnapshot, TestOpen) {
+  auto doc = svg_test::FeatureScene();
+  TempFile file;
+  {
+    svg::FdSink sink(file.fd);
+    svg::SaveSnapshot(doc, sink);
+  }
+
+  auto snapshot = svg::Snapshot::Open(file.path);
+  auto copy = snapshot;
+  EXPECT_EQ(Render(doc), Render(copy));
+
+  EXPECT_THROW(svg::Snapshot::Open("/nonexistent/snapshot"),
+               std::system_error);
+}
+
+TEST(TestSnapshot, TestInvalid) {
+  auto bytes = Save(svg_test::FeatureScene());
+
+  auto bad_magic = bytes;
+  bad_magic[0] = 'X';
+  auto bad_version = bytes;
+  uint32_t version = svg::Snapshot::kVersion + 1;
+  std::memcpy(bad_version.data() + 8, &version, sizeof(version));
+  auto bad_order = bytes;
+  bad_order[12] ^= 0xff;
+
+  struct TestCase {
+    std::string name;
+    std::string bytes;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Empty", .bytes = ""},
+      TestCase{.name = "Magic", .bytes = bad_magic},
+      TestCase{.name = "Version", .bytes = bad_version},
+      TestCase{.name = "Byte order", .bytes = bad_order},
+      TestCase{.name = "Truncated", .bytes = bytes.substr(0, bytes.size() / 2)},
+  };
+
+  for (auto &[name, data] : test_cases) {
+    EXPECT_THROW(svg::Snapshot::FromBytes(data), std::runtime_error) << name;
+  }
+}
@@ -0,0 +1,153 @@
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/style.h"
+
+#define PREFIX "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"                \
+               "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">"
+#define POSTFIX "</svg>"
+#define SVG_DOC(body) PREFIX body POSTFIX
+
+TEST(TestStyle, TestStyleSheet) {
+  svg::StyleSheet style_sheet;
+  svg::Style red{.fill_color = svg::Property::Intern("red")};
+  svg::Style rgb{.fill_color = svg::Property::Intern(svg::Rgb{1, 2, 3}),
+                 .linecap = svg::Property::Intern("round")};
+
+  EXPECT_EQ(0u, style_sheet.Add(red));
+  EXPECT_EQ(1u, style_sheet.Add(rgb));
+  EXPECT_EQ(0u, style_sheet.Add(
+      svg::Style{.fill_color = svg::Property::Intern(svg::Color{"red"})}));
+  EXPECT_EQ(1u, *style_sheet.Find(rgb));
+  EXPECT_FALSE(style_sheet.Find(svg::Style{}).has_value());
+  EXPECT_FALSE(style_sheet.Add(
+      svg::Style{.fill_color = svg::Property::Intern("red;}")}).has_value());
+  EXPECT_FALSE(style_sheet.Add(
+      svg::Style{.linejoin = svg::Property::Intern("a/*")}).has_value());
+  EXPECT_EQ(2u, style_sheet.Size());
+}
+
+TEST(TestStyle, TestDeduplicate) {
+  struct TestCase {
+    std::string name;
+    std::vector<svg::Object> objects;
+    std::string want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Empty document",
+          .want = SVG_DOC("")
+      },
+      TestCase{
+          .name = "Shared styles",
+          .objects = {
+              svg::Circle{},
+              svg::Rectangle{}.SetFillColor("red").SetStrokeLineJoin("round"),
+              svg::Text{}.SetFillColor("red").SetStrokeLineJoin("round"),
+              svg::Polyline{}},
+          .want = SVG_DOC(
+                      "<style>"
+                      ".s0{fill:none;stroke:none;stroke-width:1}"
+                      ".s1{fill:red;stroke:none;stroke-width:1;"
+                      "stroke-linejoin:round}"
+                      "</style>"
+                      "<circle class=\"s0\" cx=\"0\" cy=\"0\" r=\"1\"/>"
+                      "<rect x=\"0\" y=\"0\" width=\"0\" height=\"0\" "
+                      "class=\"s1\" />"
+                      "<text class=\"s1\" x=\"0\" y=\"0\" dx=\"0\" dy=\"0\" "
+                      "font-size=\"1\"></text>"
+                      "<polyline class=\"s0\" points=\"\"/>")
+      },
+      TestCase{
+          .name = "Sections keep their attributes",
+          .objects = {
+              svg::SectionBuilder{}.Add(svg::Circle{}).Build(),
+              svg::Circle{}.SetStrokeWidth(2)},
+          .want = SVG_DOC(
+                      "<style>.s0{fill:none;stroke:none;stroke-width:2}"
+                      "</style>"
+                      "<circle fill=\"none\" stroke=\"none\" "
+                      "stroke-width=\"1\" cx=\"0\" cy=\"0\" r=\"1\"/>"
+                      "<circle class=\"s0\" cx=\"0\" cy=\"0\" r=\"1\"/>")
+      },
+      TestCase{
+          .name = "Styles unsafe in CSS keep their attributes",
+          .objects = {
+              svg::Circle{}.SetFillColor("red}"),
+              svg::Circle{}.SetStrokeLineCap("round;"),
+              svg::Circle{}.SetFillColor("rgba(1, 2, 3, 0.5)")},
+          .want = SVG_DOC(
+                      "<style>.s0{fill:rgba(1, 2, 3, 0.5);stroke:none;"
+                      "stroke-width:1}</style>"
+                      "<circle fill=\"red}\" stroke=\"none\" "
+                      "stroke-width=\"1\" cx=\"0\" cy=\"0\" r=\"1\"/>"
+                      "<circle fill=\"none\" stroke=\"none\" "
+                      "stroke-width=\"1\" stroke-linecap=\"round;\" "
+                      "cx=\"0\" cy=\"0\" r=\"1\"/>"
+                      "<circle class=\"s0\" cx=\"0\" cy=\"0\" r=\"1\"/>")
+      },
+  };
+
+  for (auto &[name, objects, want] : test_cases) {
+    svg::Document doc;
+    for (auto &object : objects) {
+      doc.Add(std::move(object));
+    }
+
+    std::ostringstream ss;
+    doc.Render(ss, {.deduplicate_styles = true});
+    auto got = ss.str();
+
+    EXPECT_EQ(want, got) << name;
+  }
+}
+
+TEST(TestStyle, TestDeduplicateParallel) {
+  svg::Document doc;
+  for (int i = 0; i < 3000; ++i) {
+    doc.Add(svg::Circle{}.SetCenter({1.0 * i, 2.0 * i}).SetStrokeWidth(i % 5));
+  }
+
+  std::ostringstream want;
+  doc.Render(want, {.deduplicate_styles = true});
+  std::ostringstream got;
+  doc.Render(got, {.deduplicate_styles = true, .threads = 4});
+
+  EXPECT_EQ(want.str(), got.str());
+}
+
+TEST(TestStyle, TestDeduplicateCached) {
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({0, 0}).SetFillColor("red"));
+  doc.Add(svg::Circle{}.SetCenter({10, 0}).SetFillColor("blue"));
+  auto render = [&doc](const svg::RenderOptions &options) {
+    std::ostringstream ss;
+    doc.Render(ss, options);
+    return ss.str();
+  };
+  render({.deduplicate_styles = true});
+
+  // Only the classes of visible objects are written, numbered from 0.
+  EXPECT_EQ(render({.viewport = svg::Box{{9, -1}, {11, 1}},
+                    .deduplicate_styles = true}),
+            SVG_DOC("<style>.s0{fill:blue;stroke:none;stroke-width:1}"
+                    "</style>"
+                    "<circle class=\"s0\" cx=\"10\" cy=\"0\" r=\"1\"/>"));
+
+  // Adding an object drops the classes found by the previous renders.
+  doc.Add(svg::Circle{}.SetCenter({20, 0}).SetFillColor("green"));
+  EXPECT_EQ(render({.viewport = svg::Box{{19, -1}, {21, 1}},
+                    .deduplicate_styles = true}),
+            SVG_DOC("<style>.s0{fill:green;stroke:none;stroke-width:1}"
+                    "</style>"
+                    "<circle class=\"s0\" cx=\"20\" cy=\"0\" r=\"1\"/>"));
+}
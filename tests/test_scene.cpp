@@ -0,0 +1,176 @@
+#include "tests/test_scene.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/simplify.h"
+
+namespace svg_test {
+namespace {
+constexpr const char *kColors[] = {"white", "black", "red", "green", "blue"};
+// Some need escaping.
+constexpr const char *kWords[] = {"Central", "Station", "Park & Ride",
+                                  "<Square>", "Market", "\"Bridge\""};
+
+class Generator {
+ public:
+  explicit Generator(uint32_t seed) : gen_(seed) {}
+
+  // Every other object has coordinates rounded to 2 decimals.
+  void StartObject() {
+    rounded_ = !rounded_;
+  }
+
+  svg::Point NextPoint() {
+    return Coordinates({coord_(gen_), coord_(gen_)});
+  }
+  svg::Point Step(svg::Point point) {
+    return Coordinates({point.x + step_(gen_), point.y + step_(gen_)});
+  }
+  const char *NextColor() {
+    return kColors[gen_() % std::size(kColors)];
+  }
+
+  svg::Circle NextCircle() {
+    return svg::Circle{}.SetCenter(NextPoint()).SetRadius(gen_() % 5 + 1)
+        .SetFillColor(NextColor());
+  }
+  svg::Polyline NextPolyline() {
+    svg::Polyline polyline;
+    svg::Point point = NextPoint();
+    size_t count = 2 + gen_() % 20;
+    polyline.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      polyline.AddPoint(point);
+      point = Step(point);
+    }
+    return polyline.SetStrokeColor(NextColor()).SetStrokeWidth(2)
+        .SetStrokeLineCap("round").SetStrokeLineJoin("round");
+  }
+  svg::Path NextPath() {
+    svg::Path path;
+    svg::Point point = NextPoint();
+    path.MoveTo(point);
+    size_t count = 1 + gen_() % 10;
+    for (size_t i = 0; i < count; ++i) {
+      point = Step(point);
+      path.LineTo(point);
+    }
+    if (gen_() % 2 == 0) {
+      path.Close();
+    }
+    return path.SetFillColor(NextColor()).SetStrokeWidth(0.5);
+  }
+  svg::Text NextText() {
+    std::string data = kWords[gen_() % std::size(kWords)];
+    data += ' ';
+    data += kWords[gen_() % std::size(kWords)];
+    return svg::Text{}.SetPoint(NextPoint()).SetOffset({7, -3})
+        .SetFontSize(13).SetFontFamily("Verdana").SetData(data)
+        .SetFillColor("black");
+  }
+  svg::Rectangle NextRectangle() {
+    return svg::Rectangle{}.SetPoint(NextPoint()).SetWidth(40).SetHeight(20)
+        .SetFillColor(svg::Rgba{255, 255, 255, 0.85});
+  }
+
+  // 40% circles, 30% polylines, 10% each paths, texts and rectangles.
+  svg::Object NextObject() {
+    StartObject();
+    auto kind = gen_() % 10;
+    if (kind < 4) {
+      return NextCircle();
+    } else if (kind < 7) {
+      return NextPolyline();
+    } else if (kind < 8) {
+      return NextPath();
+    } else if (kind < 9) {
+      return NextText();
+    }
+    return NextRectangle();
+  }
+
+ private:
+  svg::Point Coordinates(svg::Point point) const {
+    if (rounded_) {
+      point.x = std::round(point.x * 100) / 100;
+      point.y = std::round(point.y * 100) / 100;
+    }
+    return point;
+  }
+
+  std::mt19937 gen_;
+  std::uniform_real_distribution<double> coord_{0, 10000};
+  std::uniform_real_distribution<double> step_{-50, 50};
+  bool rounded_ = false;
+};
+}
+
+std::vector<svg::Object> Scene(size_t count, uint32_t seed) {
+  Generator generator(seed);
+  std::vector<svg::Object> objects;
+  objects.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    objects.push_back(generator.NextObject());
+  }
+  return objects;
+}
+
+svg::Document SceneDocument(size_t count, uint32_t seed) {
+  svg::Document doc;
+  for (auto &object : Scene(count, seed)) {
+    doc.Add(std::move(object));
+  }
+  return doc;
+}
+
+std::vector<svg::Circle> Circles(size_t count, uint32_t seed) {
+  Generator generator(seed);
+  std::vector<svg::Circle> circles;
+  circles.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    generator.StartObject();
+    circles.push_back(generator.NextCircle());
+  }
+  return circles;
+}
+
+svg::Document FeatureScene() {
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({1, 2}).SetRadius(3).SetFillColor("red"));
+  doc.Add(svg::Polyline{}.AddPoint({0, 0}).AddPoint({5, 0.01})
+              .AddPoint({10, 0}).SetStrokeColor(svg::Rgb{1, 2, 3})
+              .SetStrokeLineCap("round").SetStrokeLineJoin("bevel"));
+  doc.Add(svg::Polyline{}.AddPoint({0, 0}).AddPoint({5, 0.01})
+              .AddPoint({10, 0})
+              .SetSimplification({svg::SimplifyAlgorithm::kVisvalingam, 1}));
+  doc.Add(svg::Polyline{}.SetFillColor("blue"));
+  doc.Add(svg::Text{}.SetPoint({4, 5}).SetOffset({1, -1}).SetFontSize(12)
+              .SetFontFamily("Tom & Jerry").SetFontWeight("bold")
+              .SetData("Fish & <Chips>").SetStrokeWidth(0.5));
+  doc.Add(svg::Text{});
+  doc.Add(svg::Rectangle{}.SetPoint({7, 8}).SetWidth(4).SetHeight(2.5)
+              .SetFillColor(svg::Rgba{1, 2, 3, 0.25}));
+  doc.Add(svg::SectionBuilder{}
+              .Add(svg::Circle{}.SetCenter({100, 100}))
+              .Add(svg::Text{}.SetData("in section"))
+              .Build());
+  doc.Add(svg::Circle{}.SetCenter({-50, 1e-3}).SetFillColor("red"));
+  return doc;
+}
+
+void FailingSink::Write(std::string_view) {
+  throw std::runtime_error("disk full");
+}
+}
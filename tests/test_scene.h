@@ -0,0 +1,37 @@
+#ifndef SVG_TESTS_TEST_SCENE_H_
+#define SVG_TESTS_TEST_SCENE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/writer.h"
+
+namespace svg_test {
+constexpr uint32_t kSceneSeed = 42;
+
+// Map-like synthetic scene over a 10000 x 10000 area: objects of every
+// figure type in a few styles, labels that need escaping, and every other
+// object with coordinates rounded to 2 decimals. The same seed always gives
+// the same objects.
+std::vector<svg::Object> Scene(size_t count, uint32_t seed = kSceneSeed);
+svg::Document SceneDocument(size_t count, uint32_t seed = kSceneSeed);
+// Circles generated the same way.
+std::vector<svg::Circle> Circles(size_t count, uint32_t seed = kSceneSeed);
+
+// One object of every kind with the values that need care on output:
+// escaped text, simplification, empty figures, a section and numbers close
+// to zero. Used by the tests of the formats reading output back.
+svg::Document FeatureScene();
+
+// Throws std::runtime_error on every write.
+class FailingSink final : public svg::Sink {
+ public:
+  void Write(std::string_view data) override;
+};
+}
+
+#endif // SVG_TESTS_TEST_SCENE_H_
@@ -0,0 +1,174 @@
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+#include "svg/render_stats.h"
+#include "svg/thread_pool.h"
+#include "svg/tiles.h"
+#include "svg/writer.h"
+
+// Every tile of the tests is 10 by 10.
+#define PREFIX "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"                \
+               "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" "  \
+               "width=\"10\" height=\"10\" viewBox=\"0 0 10 10\">"
+#define POSTFIX "</svg>"
+#define SVG_DOC(body) PREFIX body POSTFIX
+#define STYLE "fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+
+namespace {
+// Output of every tile of a grid, row by row.
+class TileSinks {
+ public:
+  explicit TileSinks(const svg::TileGrid &grid)
+      : columns_(grid.columns), outs_(grid.columns * grid.rows) {
+    for (auto &out : outs_) {
+      sinks_.push_back(std::make_unique<svg::StringSink>(out));
+    }
+  }
+
+  svg::TileSinkFn SinkOf() {
+    return [this](size_t column, size_t row) -> svg::Sink & {
+      return *sinks_[row * columns_ + column];
+    };
+  }
+  const std::string &Out(size_t column, size_t row) const {
+    return outs_[row * columns_ + column];
+  }
+
+ private:
+  size_t columns_;
+  std::vector<std::string> outs_;
+  std::vector<std::unique_ptr<svg::Sink>> sinks_;
+};
+}
+
+TEST(TestTiles, TestSplit) {
+  svg::TileGrid grid{.origin = {100, 200}, .tile_width = 10,
+                     .tile_height = 10, .columns = 2, .rows = 2};
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({105, 205}).SetRadius(1));
+  doc.Add(svg::Circle{}.SetCenter({115, 205}).SetRadius(1));
+  doc.Add(svg::Polyline{}.AddPoint({105, 205}).AddPoint({115, 215}));
+  doc.Add(svg::Rectangle{}.SetPoint({112, 212}).SetWidth(2).SetHeight(2));
+  // Outside of the grid.
+  doc.Add(svg::Circle{}.SetCenter({50, 50}));
+
+  TileSinks sinks(grid);
+  svg::RenderTiles(doc, grid, sinks.SinkOf());
+
+  EXPECT_EQ(sinks.Out(0, 0), SVG_DOC(
+      "<circle " STYLE "cx=\"5\" cy=\"5\" r=\"1\"/>"
+      "<polyline " STYLE "points=\"5,5 15,15\"/>"));
+  EXPECT_EQ(sinks.Out(1, 0), SVG_DOC(
+      "<circle " STYLE "cx=\"5\" cy=\"5\" r=\"1\"/>"
+      "<polyline " STYLE "points=\"-5,5 5,15\"/>"));
+  EXPECT_EQ(sinks.Out(0, 1), SVG_DOC(
+      "<polyline " STYLE "points=\"5,-5 15,5\"/>"));
+  EXPECT_EQ(sinks.Out(1, 1), SVG_DOC(
+      "<polyline " STYLE "points=\"-5,-5 5,5\"/>"
+      "<rect x=\"2\" y=\"2\" width=\"2\" height=\"2\" " STYLE "/>"));
+}
+
+TEST(TestTiles, TestSection) {
+  svg::TileGrid grid{.origin = {10, 0}, .tile_width = 10,
+                     .tile_height = 10};
+  svg::Document doc;
+  doc.Add(svg::SectionBuilder{}.Add(svg::Circle{}.SetCenter({15, 5}))
+              .Build());
+
+  TileSinks sinks(grid);
+  svg::RenderTiles(doc, grid, sinks.SinkOf());
+  EXPECT_EQ(sinks.Out(0, 0), SVG_DOC(
+      "<g transform=\"translate(-10 0)\">"
+      "<circle " STYLE "cx=\"15\" cy=\"5\" r=\"1\"/></g>"));
+}
+
+// Parallel tiles match the document rendered with the viewport, origin and
+// view box of every tile.
+TEST(TestTiles, TestParallel) {
+  struct TestCase {
+    std::string name;
+    svg::RenderOptions options;
+  };
+
+  svg::ThreadPool pool(3);
+  std::vector<TestCase> test_cases{
+      TestCase{.name = "Serial", .options = {}},
+      TestCase{.name = "Own pool", .options = {.threads = 4}},
+      TestCase{.name = "Executor",
+               .options = {.threads = 3, .executor = &pool}},
+      TestCase{.name = "Paths", .options = {.polylines_as_paths = true,
+                                            .precision = 2,
+                                            .threads = 4}},
+  };
+
+  auto doc = svg_test::SceneDocument(10000);
+  svg::TileGrid grid{.tile_width = 1000, .tile_height = 1250, .columns = 10,
+                     .rows = 8};
+
+  for (auto &[name, options] : test_cases) {
+    TileSinks sinks(grid);
+    svg::RenderTiles(doc, grid, sinks.SinkOf(), options);
+
+    auto serial = options;
+    serial.threads = 1;
+    serial.executor = nullptr;
+    for (size_t row = 0; row < grid.rows; ++row) {
+      for (size_t column = 0; column < grid.columns; ++column) {
+        serial.viewport = grid.TileBounds(column, row);
+        serial.origin = serial.viewport->min;
+        serial.view_box = svg::Box{{0, 0}, {1000, 1250}};
+        std::string want;
+        {
+          svg::StringSink sink(want);
+          svg::Writer writer(sink);
+          doc.Render(writer, serial);
+        }
+        EXPECT_EQ(sinks.Out(column, row), want)
+            << name << " " << column << " " << row;
+      }
+    }
+  }
+}
+
+TEST(TestTiles, TestErrors) {
+  svg::TileGrid grid{.tile_width = 10, .tile_height = 10, .columns = 3,
+                     .rows = 3};
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({15, 15}));
+
+  TileSinks sinks(grid);
+  svg_test::FailingSink failing;
+  auto sink_of = [&](size_t column, size_t row) -> svg::Sink & {
+    return column == 1 && row == 0 ? failing : sinks.SinkOf()(column, row);
+  };
+  EXPECT_THROW(svg::RenderTiles(doc, grid, sink_of, {.threads = 2}),
+               std::runtime_error);
+  // The other tiles are written.
+  EXPECT_EQ(sinks.Out(1, 1), SVG_DOC(
+      "<circle " STYLE "cx=\"5\" cy=\"5\" r=\"1\"/>"));
+  EXPECT_EQ(sinks.Out(2, 2), SVG_DOC(""));
+}
+
+TEST(TestTiles, TestStats) {
+  svg::TileGrid grid{.tile_width = 10, .tile_height = 10, .columns = 2};
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({5, 5}));
+  doc.Add(svg::Circle{}.SetCenter({10, 5}));
+
+  TileSinks sinks(grid);
+  svg::RenderStats stats;
+  svg::RenderTiles(doc, grid, sinks.SinkOf(), {.threads = 2,
+                                                .stats = &stats});
+  // The circle on the border is in both tiles.
+  EXPECT_EQ(stats.circles.count, 3u);
+}
@@ -0,0 +1,177 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tests/test_scene.h"
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/render_options.h"
+
+namespace {
+bool operator==(const svg::Box &lhs, const svg::Box &rhs) {
+  return lhs.min.x == rhs.min.x && lhs.min.y == rhs.min.y &&
+      lhs.max.x == rhs.max.x && lhs.max.y == rhs.max.y;
+}
+
+std::string Render(const svg::Document &doc, const svg::Box &viewport) {
+  std::ostringstream ss;
+  doc.Render(ss, {.viewport = viewport});
+  return ss.str();
+}
+}
+
+TEST(TestViewport, TestBounds) {
+  struct TestCase {
+    std::string name;
+    svg::Object object;
+    svg::Box want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Circle",
+          .object = svg::Circle{}.SetCenter({10, 20}).SetRadius(2),
+          .want = {{7.5, 17.5}, {12.5, 22.5}}
+      },
+      TestCase{
+          .name = "Polyline",
+          .object = svg::Polyline{}
+              .AddPoint({1, 5}).AddPoint({-3, 2}).SetStrokeWidth(0),
+          .want = {{-3, 2}, {1, 5}}
+      },
+      TestCase{
+          .name = "Empty polyline",
+          .object = svg::Polyline{},
+          .want = {}
+      },
+      TestCase{
+          .name = "Text",
+          .object = svg::Text{}
+              .SetPoint({10, 20}).SetOffset({1, 2}).SetFontSize(10)
+              .SetData("abc").SetStrokeWidth(0),
+          .want = {{11, 12}, {41, 27}}
+      },
+      TestCase{
+          .name = "Rectangle",
+          .object = svg::Rectangle{}
+              .SetPoint({1, 2}).SetWidth(3).SetHeight(4).SetStrokeWidth(2),
+          .want = {{0, 1}, {5, 7}}
+      },
+      TestCase{
+          .name = "Section",
+          .object = svg::SectionBuilder{}
+              .Add(svg::Circle{}.SetStrokeWidth(0))
+              .Add(svg::Rectangle{}.SetPoint({5, 5}).SetStrokeWidth(0))
+              .Build(),
+          .want = {{-1, -1}, {5, 5}}
+      },
+      TestCase{
+          .name = "Empty section",
+          .object = svg::SectionBuilder{}.Build(),
+          .want = {}
+      },
+  };
+
+  for (auto &[name, object, want] : test_cases) {
+    auto got = svg::Bounds(object);
+
+    EXPECT_TRUE(want == got) << name;
+  }
+}
+
+TEST(TestViewport, TestRender) {
+  auto near = svg::Circle{}.SetCenter({1, 1});
+  auto far = svg::Circle{}.SetCenter({100, 100});
+  auto line = svg::Polyline{}.AddPoint({0, 0}).AddPoint({100, 100});
+
+  svg::Document doc;
+  doc.Add(line);
+  doc.Add(far);
+  doc.Add(near);
+
+  std::ostringstream want;
+  {
+    svg::Document visible;
+    visible.Add(line);
+    visible.Add(near);
+    visible.Render(want);
+  }
+  EXPECT_EQ(want.str(), Render(doc, {{-5, -5}, {5, 5}}));
+
+  std::ostringstream empty;
+  svg::Document{}.Render(empty);
+  EXPECT_EQ(empty.str(), Render(doc, {{200, 200}, {300, 300}}));
+
+  doc.Add(svg::Circle{}.SetCenter({250, 250}));
+  EXPECT_NE(empty.str(), Render(doc, {{200, 200}, {300, 300}}))
+            << "Index is rebuilt after Add";
+
+  // Braced default options are not ambiguous with a viewport.
+  std::ostringstream all, defaults;
+  doc.Render(all);
+  doc.Render(defaults, {});
+  EXPECT_EQ(all.str(), defaults.str());
+}
+
+TEST(TestViewport, TestManyObjects) {
+  auto circles = svg_test::Circles(2000);
+  svg::Document doc;
+  for (auto &circle : circles) {
+    doc.Add(circle);
+  }
+
+  // Viewports sweep the scene diagonally.
+  for (int i = 0; i < 20; ++i) {
+    double x = 490.0 * i;
+    double y = 9500.0 - 470.0 * i;
+    svg::Box viewport{{x, y}, {x + 1000, y + 500}};
+
+    svg::Document want;
+    for (auto &circle : circles) {
+      if (circle.Bounds().Intersects(viewport)) {
+        want.Add(circle);
+      }
+    }
+    std::ostringstream ss;
+    want.Render(ss);
+
+    EXPECT_EQ(ss.str(), Render(doc, viewport));
+  }
+}
+
+TEST(TestViewport, TestBuildIndex) {
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({10, 10}).SetRadius(1));
+  doc.BuildIndex();
+  doc.Add(svg::Circle{}.SetCenter({20, 20}).SetRadius(1));
+
+  svg::Box viewport{{15, 15}, {25, 25}};
+  svg::Document want;
+  want.Add(svg::Circle{}.SetCenter({20, 20}).SetRadius(1));
+  std::ostringstream ss;
+  want.Render(ss);
+  EXPECT_EQ(ss.str(), Render(doc, viewport)) << "Rebuilt after Add";
+}
+
+TEST(TestViewport, TestViewBox) {
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({20, 20}).SetRadius(1));
+
+  std::ostringstream ss;
+  doc.Render(ss, {.view_box = svg::Box{{-5, 0}, {15, 10.5}},
+                  .origin = {10, 10}});
+  EXPECT_EQ(ss.str(),
+            "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>"
+            "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" "
+            "width=\"20\" height=\"10.5\" viewBox=\"-5 0 20 10.5\">"
+            "<circle fill=\"none\" stroke=\"none\" stroke-width=\"1\" "
+            "cx=\"10\" cy=\"10\" r=\"1\"/></svg>");
+
+  EXPECT_THROW(doc.Render(ss, {.view_box = svg::Box{}}),
+               std::invalid_argument);
+}
@@ -0,0 +1,265 @@
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "svg/common.h"
+#include "svg/document.h"
+#include "svg/figures.h"
+#include "svg/writer.h"
+
+TEST(TestWriter, TestValues) {
+  std::string got;
+  {
+    svg::StringSink sink(got);
+    svg::Writer writer(sink);
+    writer << "x=" << 2.5 << ' ' << uint32_t{4294967295} << ' ' <<
+        svg::Color{svg::Rgba{1, 2, 3, 0.25}} << ' ' << svg::Color{};
+  }
+
+  EXPECT_EQ("x=2.5 4294967295 rgba(1,2,3,0.25) none", got);
+}
+
+TEST(TestWriter, TestChunks) {
+  struct TestCase {
+    std::string name;
+    size_t capacity;
+    std::vector<std::string> writes;
+    std::vector<std::string> want;
+  };
+
+  std::vector<TestCase> test_cases{
+      TestCase{
+          .name = "Fits in buffer",
+          .capacity = 64,
+          .writes = {"ab", "cd"},
+          .want = {"abcd"}
+      },
+      TestCase{
+          .name = "Flush when full",
+          .capacity = 64,
+          .writes = {std::string(40, 'a'), std::string(40, 'b')},
+          .want = {std::string(40, 'a'), std::string(40, 'b')}
+      },
+      TestCase{
+          .name = "Larger than buffer",
+          .capacity = 64,
+          .writes = {"a", std::string(100, 'b'), "c"},
+          .want = {"a", std::string(100, 'b'), "c"}
+      },
+  };
+
+  for (auto &[name, capacity, writes, want] : test_cases) {
+    std::vector<std::string> got;
+    svg::CallbackSink sink([&got](std::string_view data) {
+      got.emplace_back(data);
+    });
+    svg::Writer writer(sink, capacity);
+    for (auto &data : writes) {
+      writer << data;
+    }
+    writer.Flush();
+
+    EXPECT_EQ(want, got) << name;
+
+    // A buffer of the caller's is used the same way.
+    got.clear();
+    std::vector<char> buffer(capacity);
+    svg::Writer caller_buffer(sink, buffer.data(), buffer.size());
+    for (auto &data : writes) {
+      caller_buffer << data;
+    }
+    caller_buffer.Flush();
+
+    EXPECT_EQ(want, got) << name << " (caller buffer)";
+  }
+}
+
+TEST(TestWriter, TestFdSink) {
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+
+  svg::Document doc;
+  doc.Add(svg::Circle{}.SetCenter({1.5, 2}));
+  {
+    svg::FdSink sink(fds[1]);
+    svg::Writer writer(sink);
+    doc.Render(writer);
+  }
+  close(fds[1]);
+
+  std::string got;
+  char buf[256];
+  for (ssize_t n; (n = read(fds[0], buf, sizeof(buf))) > 0;) {
+    got.append(buf, n);
+  }
+  close(fds[0]);
+
+  std::ostringstream want;
+  doc.Render(want);
+  EXPECT_EQ(want.str(), got);
+}
+
+TEST(TestWriter, TestFigures) {
+  std::vector<svg::Object> objects{
+      svg::Circle{}.SetFillColor(svg::Rgb{1, 2, 3}),
+      svg::Polyline{}.AddPoint({1, 2}).AddPoint({3.25, 4}),
+      svg::Text{}.SetData("text").SetFontFamily("Verdana"),
+      svg::Rectangle{}.SetWidth(2).SetStrokeLineCap("round"),
+      svg::SectionBuilder{}.Add(svg::Circle{}).Build(),
+  };
+
+  for (auto &object : objects) {
+    std::ostringstream want;
+    std::string got;
+    {
+      svg::StringSink sink(got);
+      svg::Writer writer(sink, 1);
+      std::visit([&](auto &&obj) {
+        obj.Render(want);
+        obj.Render(writer);
+      }, object);
+    }
+
+    EXPECT_EQ(want.str(), got);
+  }
+}
+
+namespace {
+// Records every piece the writer hands over.
+class RecordingSink final : public svg::Sink {
+ public:
+  void Write(std::string_view data) override {
+    pieces.push_back(data);
+    bytes.append(data);
+  }
+
+  std::vector<std::string_view> pieces;
+  std::string bytes;
+};
+
+svg::Section BigSection() {
+  svg::SectionBuilder builder;
+  for (int i = 0; i < 200; ++i) {
+    builder.Add(svg::Circle{}.SetCenter({1.0 * i, 2.0 * i}));
+  }
+  return builder.Build();
+}
+}
+
+TEST(TestWriter, TestWriteVectored) {
+  std::string big(svg::Writer::kMinVectoredSize, 'b');
+  std::vector<std::string_view> pieces{"small", big, "tail"};
+
+  RecordingSink sink;
+  {
+    svg::Writer writer(sink, 64);
+    writer << "head";
+    writer.WriteVectored(pieces.data(), pieces.size());
+    writer.WriteVectored(pieces.data(), 1);
+  }
+
+  EXPECT_EQ("head" "small" + big + "tail" "small", sink.bytes);
+  ASSERT_EQ(5u, sink.pieces.size());
+  EXPECT_EQ(big.data(), sink.pieces[2].data()) << "Large piece is not copied";
+}
+
+TEST(TestWriter, TestMeasuring) {
+  std::string big(svg::Writer::kMinVectoredSize, 'b');
+  std::vector<std::string_view> pieces{"small", big};
+  auto write = [&pieces](svg::Writer &writer) {
+    writer.SetPrecision(2);
+    writer << "x=" << 1.005 << ' ' << -12.5 << ' ' << 0.001;
+    writer.WriteVectored(pieces.data(), pieces.size());
+    writer.SetPrecision(std::nullopt);
+    writer << 0.1 + 0.2;
+  };
+
+  std::string want;
+  {
+    svg::StringSink sink(want);
+    svg::Writer writer(sink);
+    write(writer);
+  }
+  auto measuring = svg::Writer::Measuring();
+  write(measuring);
+  EXPECT_EQ(want.size(), measuring.BytesWritten());
+}
+
+TEST(TestWriter, TestFdSinkVectored) {
+  auto *file = std::tmpfile();
+  ASSERT_NE(nullptr, file);
+
+  auto section = BigSection();
+  svg::Document doc;
+  doc.Add(section);
+  doc.Add(svg::Circle{});
+  doc.Add(section);
+  {
+    svg::FdSink sink(fileno(file));
+    svg::Writer writer(sink, 256);
+    doc.Render(writer);
+  }
+
+  std::string got;
+  std::rewind(file);
+  char buf[4096];
+  for (size_t n; (n = std::fread(buf, 1, sizeof(buf), file)) > 0;) {
+    got.append(buf, n);
+  }
+  std::fclose(file);
+
+  std::ostringstream want;
+  doc.Render(want);
+  EXPECT_EQ(want.str(), got);
+}
+
+TEST(TestSection, TestComposition) {
+  auto background = BigSection();
+  auto composed = svg::SectionBuilder{}
+      .Add(svg::Rectangle{})
+      .Add(background)
+      .Add(svg::SectionBuilder{}.Add(svg::Text{}).Build())
+      .Add(background)
+      .Build();
+
+  std::ostringstream want;
+  {
+    svg::Document doc;
+    doc.Add(svg::Rectangle{});
+    doc.Add(background);
+    doc.Add(svg::Text{});
+    doc.Add(background);
+    doc.Render(want);
+  }
+  std::ostringstream got;
+  {
+    svg::Document doc;
+    doc.Add(composed);
+    doc.Render(got);
+  }
+  EXPECT_EQ(want.str(), got.str());
+
+  RecordingSink sink;
+  {
+    svg::Writer writer(sink, 64);
+    composed.Render(writer);
+  }
+  std::vector<const char *> shared;
+  for (auto piece : sink.pieces) {
+    if (piece.size() >= svg::Writer::kMinVectoredSize) {
+      shared.push_back(piece.data());
+    }
+  }
+  ASSERT_EQ(2u, shared.size());
+  EXPECT_EQ(shared[0], shared[1]) << "Both copies share one buffer";
+}